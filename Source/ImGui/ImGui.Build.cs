@@ -23,6 +23,10 @@ public class ImGui : ModuleRules
 		// Enable runtime loader, if you want this module to be automatically loaded in runtime builds (monolithic).
 		bool bEnableRuntimeLoader = true;
 
+		// Use 16-bit indices in ImGui draw lists. This halves the size of index buffers and ImGui will still render large
+		// meshes by splitting them with vertex offsets. Set to false to use 32-bit indices.
+		bool bUse16BitIndices = false;
+
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 #if UE_4_24_OR_LATER
@@ -65,7 +69,10 @@ public class ImGui : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"ImGuiShaders",
 				"InputCore",
+				"RenderCore",
+				"RHI",
 				"Slate",
 				"SlateCore"
 				// ... add private dependencies that you statically link with here ...
@@ -95,9 +102,13 @@ public class ImGui : ModuleRules
 
 
 #if !UE_4_19_OR_LATER
+		List<string> PublicDefinitions = Definitions;
 		List<string> PrivateDefinitions = Definitions;
 #endif
 
+		// Index type is part of the public ImGui interface, so it needs to be visible to all dependent modules.
+		PublicDefinitions.Add(string.Format("IMGUI_USE_16BIT_INDICES={0}", bUse16BitIndices ? 1 : 0));
+
 		PrivateDefinitions.Add(string.Format("RUNTIME_LOADER_ENABLED={0}", bEnableRuntimeLoader ? 1 : 0));
 
 		// Force ImPlot to export its methods in this module DLL so we can import them in our main project
@@ -0,0 +1,768 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiBenchmarkCommandlet.h"
+
+#include "ImGuiDrawData.h"
+#include "ImGuiDrawDataCapture.h"
+#include "ImGuiDrawElement.h"
+#include "ImGuiFontAtlasCache.h"
+#include "ImGuiImplementation.h"
+#include "ImGuiVertexConversion.h"
+
+#include <HAL/PlatformTime.h>
+#include <Math/RandomStream.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Parse.h>
+
+#include <imgui.h>
+#include <implot.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiBenchmark, Log, All);
+
+namespace
+{
+	struct FTimingResult
+	{
+		double MinSeconds = 0.0;
+		double AvgSeconds = 0.0;
+	};
+
+	// Run functor a number of times and collect timings. First call is treated as a warm-up and is not measured.
+	template<typename FunctorType>
+	FTimingResult Measure(int32 Iterations, FunctorType&& Functor)
+	{
+		Functor();
+
+		FTimingResult Result;
+		Result.MinSeconds = TNumericLimits<double>::Max();
+
+		double TotalSeconds = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Functor();
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+			Result.MinSeconds = FMath::Min(Result.MinSeconds, Seconds);
+			TotalSeconds += Seconds;
+		}
+
+		Result.AvgSeconds = TotalSeconds / FMath::Max(Iterations, 1);
+		return Result;
+	}
+
+	void LogTiming(const TCHAR* Name, const FTimingResult& Timing, int32 NumVertices)
+	{
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  %-12s min %8.3f ms, avg %8.3f ms, %8.2f Mvertices/s"), Name,
+			Timing.MinSeconds * 1000.0, Timing.AvgSeconds * 1000.0, NumVertices / Timing.MinSeconds / 1000000.0);
+	}
+
+	// Generate vertices resembling ImGui output: quads spread over a 4K canvas with random UVs and colors.
+	void GenerateVertices(TArray<ImDrawVert>& OutVertices, int32 NumVertices, int32 Seed)
+	{
+		FRandomStream Stream{ Seed };
+
+		OutVertices.SetNumUninitialized(NumVertices);
+		for (int32 Idx = 0; Idx < NumVertices; Idx++)
+		{
+			ImDrawVert& Vertex = OutVertices[Idx];
+			Vertex.pos = { Stream.FRandRange(0.f, 3840.f), Stream.FRandRange(0.f, 2160.f) };
+			Vertex.uv = { Stream.FRand(), Stream.FRand() };
+			Vertex.col = Stream.GetUnsignedInt();
+		}
+	}
+
+	// Generate draw lists made of quads, with commands using different clipping rectangles.
+	void GenerateDrawLists(TArray<FImGuiDrawList>& OutDrawLists, int32 NumLists, int32 NumVertices, int32 QuadsPerCommand, int32 Seed)
+	{
+		FRandomStream Stream{ Seed };
+
+		TArray<ImDrawVert> Vertices;
+		OutDrawLists.SetNum(NumLists);
+		for (int32 ListIndex = 0; ListIndex < NumLists; ListIndex++)
+		{
+			const int32 NumQuads = NumVertices / 4;
+			GenerateVertices(Vertices, NumQuads * 4, Seed + ListIndex);
+
+			ImDrawList Src{ nullptr };
+			Src.VtxBuffer.resize(Vertices.Num());
+			FMemory::Memcpy(Src.VtxBuffer.Data, Vertices.GetData(), Vertices.Num() * sizeof(ImDrawVert));
+
+			Src.IdxBuffer.resize(NumQuads * 6);
+			for (int32 Quad = 0; Quad < NumQuads; Quad++)
+			{
+				const ImDrawIdx Base = Quad * 4;
+				ImDrawIdx* Indices = Src.IdxBuffer.Data + Quad * 6;
+				Indices[0] = Base; Indices[1] = Base + 1; Indices[2] = Base + 2;
+				Indices[3] = Base; Indices[4] = Base + 2; Indices[5] = Base + 3;
+			}
+
+			for (int32 FirstQuad = 0; FirstQuad < NumQuads; FirstQuad += QuadsPerCommand)
+			{
+				ImDrawCmd Command;
+				Command.ClipRect = { Stream.FRandRange(0.f, 100.f), Stream.FRandRange(0.f, 100.f), 3840.f, 2160.f };
+				Command.IdxOffset = FirstQuad * 6;
+				Command.ElemCount = FMath::Min(QuadsPerCommand, NumQuads - FirstQuad) * 6;
+				Src.CmdBuffer.push_back(Command);
+			}
+
+			OutDrawLists[ListIndex].TransferDrawData(Src);
+		}
+	}
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	int32 RunVertexConversion(const FString& Params)
+	{
+		int32 NumVertices = 300000;
+		int32 Iterations = 100;
+		int32 Seed = 0;
+		FParse::Value(*Params, TEXT("Vertices="), NumVertices);
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+
+		TArray<ImDrawVert> ImGuiVertices;
+		GenerateVertices(ImGuiVertices, NumVertices, Seed);
+
+		TArray<FSlateVertex> ScalarVertices;
+		TArray<FSlateVertex> VectorizedVertices;
+		ScalarVertices.SetNumZeroed(NumVertices);
+		VectorizedVertices.SetNumZeroed(NumVertices);
+
+		// Typical ImGui to screen transform with canvas offset and zoom.
+		const FTransform2D Transform{ FScale2D{ 1.25f }, FVector2D{ 13.f, 7.f } };
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("VertexConversion: %d vertices, %d iterations, vectorized by default: %s"),
+			NumVertices, Iterations, ImGuiVertexConversion::IsVectorized() ? TEXT("yes") : TEXT("no"));
+
+		const FTimingResult Scalar = Measure(Iterations, [&]()
+		{
+			ImGuiVertexConversion::ConvertScalar(ImGuiVertices.GetData(), ScalarVertices.GetData(), NumVertices, Transform);
+		});
+
+		const FTimingResult Vectorized = Measure(Iterations, [&]()
+		{
+			ImGuiVertexConversion::ConvertVectorized(ImGuiVertices.GetData(), VectorizedVertices.GetData(), NumVertices, Transform);
+		});
+
+		LogTiming(TEXT("Scalar:"), Scalar, NumVertices);
+		LogTiming(TEXT("Vectorized:"), Vectorized, NumVertices);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Speed-up:    %.2fx"), Scalar.MinSeconds / Vectorized.MinSeconds);
+
+		// Validate that both conversions produce the same output (positions may differ by rounding).
+		float MaxPositionError = 0.f;
+		int32 NumMismatches = 0;
+		for (int32 Idx = 0; Idx < NumVertices; Idx++)
+		{
+			const FSlateVertex& A = ScalarVertices[Idx];
+			const FSlateVertex& B = VectorizedVertices[Idx];
+
+			MaxPositionError = FMath::Max(MaxPositionError, FMath::Max(FMath::Abs(A.Position.X - B.Position.X), FMath::Abs(A.Position.Y - B.Position.Y)));
+			if (A.Color != B.Color || FMemory::Memcmp(A.TexCoords, B.TexCoords, sizeof(A.TexCoords)) != 0)
+			{
+				NumMismatches++;
+			}
+		}
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Validation:  max position error %g, %d mismatched colors or UVs"), MaxPositionError, NumMismatches);
+
+		return (NumMismatches == 0 && MaxPositionError < 0.01f) ? 0 : 1;
+	}
+
+	int32 RunTransformSpecialization(const FString& Params)
+	{
+		using ImGuiVertexConversion::ETransformType;
+
+		int32 NumVertices = 300000;
+		int32 Iterations = 100;
+		int32 Seed = 0;
+		FParse::Value(*Params, TEXT("Vertices="), NumVertices);
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+
+		TArray<ImDrawVert> ImGuiVertices;
+		GenerateVertices(ImGuiVertices, NumVertices, Seed);
+
+		TArray<FSlateVertex> GeneralVertices;
+		TArray<FSlateVertex> SpecializedVertices;
+		GeneralVertices.SetNumZeroed(NumVertices);
+		SpecializedVertices.SetNumZeroed(NumVertices);
+
+		struct FCase
+		{
+			const TCHAR* Name;
+			FTransform2D Transform;
+		};
+
+		const FCase Cases[] =
+		{
+			{ TEXT("Identity"), FTransform2D{} },
+			{ TEXT("Translation"), FTransform2D{ FVector2D{ 13.f, 7.f } } },
+			{ TEXT("UniformScale"), FTransform2D{ FScale2D{ 1.25f }, FVector2D{ 13.f, 7.f } } },
+			{ TEXT("General"), FTransform2D{ FQuat2D{ 0.1f }, FVector2D{ 13.f, 7.f } } },
+		};
+
+		const TCHAR* TransformTypeNames[] = { TEXT("Identity"), TEXT("Translation"), TEXT("UniformScale"), TEXT("General") };
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("TransformSpecialization: %d vertices, %d iterations"), NumVertices, Iterations);
+
+		int32 Result = 0;
+		for (const FCase& Case : Cases)
+		{
+			const ETransformType TransformType = ImGuiVertexConversion::GetTransformType(Case.Transform);
+
+			const FTimingResult General = Measure(Iterations, [&]()
+			{
+				ImGuiVertexConversion::ConvertVectorized(ImGuiVertices.GetData(), GeneralVertices.GetData(), NumVertices, Case.Transform, ETransformType::General);
+			});
+
+			const FTimingResult Specialized = Measure(Iterations, [&]()
+			{
+				ImGuiVertexConversion::ConvertVectorized(ImGuiVertices.GetData(), SpecializedVertices.GetData(), NumVertices, Case.Transform, TransformType);
+			});
+
+			float MaxPositionError = 0.f;
+			for (int32 Idx = 0; Idx < NumVertices; Idx++)
+			{
+				const FSlateVertex& A = GeneralVertices[Idx];
+				const FSlateVertex& B = SpecializedVertices[Idx];
+				MaxPositionError = FMath::Max(MaxPositionError, FMath::Max(FMath::Abs(A.Position.X - B.Position.X), FMath::Abs(A.Position.Y - B.Position.Y)));
+			}
+
+			UE_LOG(LogImGuiBenchmark, Display, TEXT(" %s (detected as %s):"), Case.Name, TransformTypeNames[(int32)TransformType]);
+			LogTiming(TEXT("General:"), General, NumVertices);
+			LogTiming(TEXT("Specialized:"), Specialized, NumVertices);
+			UE_LOG(LogImGuiBenchmark, Display, TEXT("  Speed-up:    %.2fx, max position error %g"), General.MinSeconds / Specialized.MinSeconds, MaxPositionError);
+
+			if (MaxPositionError >= 0.01f)
+			{
+				Result = 1;
+			}
+		}
+
+		return Result;
+	}
+
+	int32 RunReplay(const FString& Params)
+	{
+		FString Filename;
+		int32 Iterations = 10;
+		float Scale = 1.f;
+		FParse::Value(*Params, TEXT("File="), Filename);
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+		FParse::Value(*Params, TEXT("Scale="), Scale);
+
+		TArray<FImGuiCapturedFrame> Frames;
+		FString Error;
+		if (!ImGuiDrawDataReplay::LoadCapture(Filename, Frames, Error))
+		{
+			UE_LOG(LogImGuiBenchmark, Error, TEXT("%s"), *Error);
+			return 1;
+		}
+
+		if (!Error.IsEmpty())
+		{
+			UE_LOG(LogImGuiBenchmark, Warning, TEXT("%s"), *Error);
+		}
+
+		const FTransform2D Transform{ FScale2D{ Scale } };
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("Replay: '%s', %d frames, %d iterations, scale %g"), *Filename, Frames.Num(), Iterations, Scale);
+
+		// Frames are replayed in order through the same conversion path that is used by widgets. Output is not reused
+		// between frames, so every frame is fully converted like after a transform change.
+		TArray<FImGuiSlateDrawList> SlateDrawLists;
+		int32 TotalVertices = 0;
+		int32 TotalBatches = 0;
+		double MaxFrameSeconds = 0.0;
+		int32 MaxFrame = 0;
+
+		const FTimingResult Replay = Measure(Iterations, [&]()
+		{
+			TotalVertices = 0;
+			TotalBatches = 0;
+			for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); FrameIndex++)
+			{
+				const FImGuiCapturedFrame& Frame = Frames[FrameIndex];
+				const FSlateRect CullingRect = TransformRect(Transform, FSlateRect{ FVector2D::ZeroVector, Frame.DisplaySize });
+
+				const double StartTime = FPlatformTime::Seconds();
+
+				SlateDrawLists.SetNum(Frame.DrawLists.Num());
+				for (int32 Index = 0; Index < Frame.DrawLists.Num(); Index++)
+				{
+					Frame.DrawLists[Index].CopyDrawData(SlateDrawLists[Index], Transform, CullingRect);
+				}
+
+				const double FrameSeconds = FPlatformTime::Seconds() - StartTime;
+				if (FrameSeconds > MaxFrameSeconds)
+				{
+					MaxFrameSeconds = FrameSeconds;
+					MaxFrame = FrameIndex;
+				}
+
+				for (int32 Index = 0; Index < Frame.DrawLists.Num(); Index++)
+				{
+					TotalVertices += Frame.DrawLists[Index].NumVertices();
+					TotalBatches += SlateDrawLists[Index].Batches.Num();
+				}
+			}
+		});
+
+		LogTiming(TEXT("Capture:"), Replay, TotalVertices);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Per frame:   avg %8.3f ms, worst %8.3f ms (frame %d)"),
+			Replay.MinSeconds * 1000.0 / FMath::Max(Frames.Num(), 1), MaxFrameSeconds * 1000.0, MaxFrame);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Output:      %d vertices, %d batches"), TotalVertices, TotalBatches);
+
+		return 0;
+	}
+
+	// Allocator forwarding to the previous ImGui allocator and counting allocations made by ImGui.
+	struct FCountingAllocator
+	{
+		FCountingAllocator()
+		{
+			ImGui::GetAllocatorFunctions(&PrevAlloc, &PrevFree, &PrevUserData);
+			ImGui::SetAllocatorFunctions(&Alloc, &Free, this);
+		}
+
+		~FCountingAllocator()
+		{
+			ImGui::SetAllocatorFunctions(PrevAlloc, PrevFree, PrevUserData);
+		}
+
+		FCountingAllocator(const FCountingAllocator&) = delete;
+		FCountingAllocator& operator=(const FCountingAllocator&) = delete;
+
+		static void* Alloc(size_t Size, void* UserData)
+		{
+			FCountingAllocator& Self = *static_cast<FCountingAllocator*>(UserData);
+			Self.NumAllocations++;
+			Self.AllocatedBytes += Size;
+			return Self.PrevAlloc(Size, Self.PrevUserData);
+		}
+
+		static void Free(void* Ptr, void* UserData)
+		{
+			FCountingAllocator& Self = *static_cast<FCountingAllocator*>(UserData);
+			Self.PrevFree(Ptr, Self.PrevUserData);
+		}
+
+		ImGuiMemAllocFunc PrevAlloc = nullptr;
+		ImGuiMemFreeFunc PrevFree = nullptr;
+		void* PrevUserData = nullptr;
+
+		uint64 NumAllocations = 0;
+		uint64 AllocatedBytes = 0;
+	};
+
+	// Run a number of frames in a private ImGui context, drawing the UI with the given functor, and measure each stage of
+	// the frame up to conversion to Slate format. Only the font atlas texture data are built, so it can run headless.
+	template<typename FunctorType>
+	int32 RunImGuiFrames(const TCHAR* Name, const FString& Params, FunctorType&& DrawUI)
+	{
+		int32 Frames = 100;
+		FParse::Value(*Params, TEXT("Frames="), Frames);
+		Frames = FMath::Max(Frames, 1);
+
+		// Allocator needs to outlive the context, so allocations are freed with the same functions.
+		FCountingAllocator Allocator;
+
+		ImFontAtlas FontAtlas;
+		FontAtlas.AddFontDefault();
+		FontAtlas.Build();
+
+		ImGuiContext* const PrevContext = ImGui::GetCurrentContext();
+		ImGuiContext* const Context = ImGui::CreateContext(&FontAtlas);
+		ImGui::SetCurrentContext(Context);
+
+		ImGuiIO& IO = ImGui::GetIO();
+		IO.IniFilename = nullptr;
+		IO.DisplaySize = { 1920.f, 1080.f };
+		IO.DeltaTime = 1.f / 60.f;
+		IO.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+		const FTransform2D Transform;
+		const FSlateRect CullingRect{ 0.f, 0.f, IO.DisplaySize.x, IO.DisplaySize.y };
+
+		TArray<FImGuiDrawList> DrawLists;
+		TArray<FImGuiSlateDrawList> SlateDrawLists;
+
+		double NewFrameSeconds = 0.0;
+		double DrawSeconds = 0.0;
+		double RenderSeconds = 0.0;
+		double ConversionSeconds = 0.0;
+		uint64 TotalVertices = 0;
+		uint64 NumAllocations = 0;
+		uint64 AllocatedBytes = 0;
+
+		// The first frame initializes windows and tables, so it is run as a warm-up and not measured.
+		for (int32 Frame = -1; Frame < Frames; Frame++)
+		{
+			const uint64 StartAllocations = Allocator.NumAllocations;
+			const uint64 StartBytes = Allocator.AllocatedBytes;
+
+			double Time = FPlatformTime::Seconds();
+			const auto Lap = [&Time]()
+			{
+				const double Now = FPlatformTime::Seconds();
+				const double Seconds = Now - Time;
+				Time = Now;
+				return Seconds;
+			};
+
+			ImGui::NewFrame();
+			const double NewFrame = Lap();
+
+			DrawUI(FMath::Max(Frame, 0), Frames);
+			const double Draw = Lap();
+
+			ImGui::Render();
+			const double Render = Lap();
+
+			const ImDrawData* DrawData = ImGui::GetDrawData();
+#if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+			DrawLists.SetNum(DrawData->CmdListsCount, false);
+			SlateDrawLists.SetNum(DrawData->CmdListsCount, false);
+#else
+			DrawLists.SetNum(DrawData->CmdListsCount, EAllowShrinking::No);
+			SlateDrawLists.SetNum(DrawData->CmdListsCount, EAllowShrinking::No);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+
+			for (int32 Index = 0; Index < DrawData->CmdListsCount; Index++)
+			{
+				DrawLists[Index].TransferDrawData(*DrawData->CmdLists[Index]);
+				DrawLists[Index].CopyDrawData(SlateDrawLists[Index], Transform, CullingRect);
+			}
+			const double Conversion = Lap();
+
+			if (Frame >= 0)
+			{
+				NewFrameSeconds += NewFrame;
+				DrawSeconds += Draw;
+				RenderSeconds += Render;
+				ConversionSeconds += Conversion;
+				TotalVertices += DrawData->TotalVtxCount;
+				NumAllocations += Allocator.NumAllocations - StartAllocations;
+				AllocatedBytes += Allocator.AllocatedBytes - StartBytes;
+			}
+		}
+
+		ImGuiImplementation::DestroyPlotContext(Context);
+		ImGui::DestroyContext(Context);
+		ImGui::SetCurrentContext(PrevContext);
+
+		const auto PerFrameMs = [Frames](double Seconds) { return Seconds * 1000.0 / Frames; };
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("%s: %d frames, %llu vertices per frame"), Name, Frames, TotalVertices / Frames);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  NewFrame:    %8.3f ms"), PerFrameMs(NewFrameSeconds));
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Draw UI:     %8.3f ms"), PerFrameMs(DrawSeconds));
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Render:      %8.3f ms"), PerFrameMs(RenderSeconds));
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Conversion:  %8.3f ms, %8.2f Mvertices/s"), PerFrameMs(ConversionSeconds),
+			ConversionSeconds > 0.0 ? TotalVertices / ConversionSeconds / 1000000.0 : 0.0);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Allocations: %llu per frame, %.2f KB per frame"), NumAllocations / Frames,
+			AllocatedBytes / 1024.0 / Frames);
+
+		return 0;
+	}
+
+	// Window covering the whole display, so workloads are not clipped by the default window size.
+	bool BeginFullscreenWindow(const char* Name)
+	{
+		ImGui::SetNextWindowPos({ 0.f, 0.f });
+		ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+		return ImGui::Begin(Name, nullptr, ImGuiWindowFlags_NoSavedSettings);
+	}
+
+	int32 RunDemo(const FString& Params)
+	{
+		return RunImGuiFrames(TEXT("Demo"), Params, [](int32 Frame, int32 Frames)
+		{
+			ImGui::SetNextWindowPos({ 0.f, 0.f });
+			ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+			ImGui::ShowDemoWindow();
+			ImPlot::ShowDemoWindow();
+		});
+	}
+
+	int32 RunTable(const FString& Params)
+	{
+		int32 Rows = 100000;
+		FParse::Value(*Params, TEXT("Rows="), Rows);
+
+		return RunImGuiFrames(TEXT("Table"), Params, [Rows](int32 Frame, int32 Frames)
+		{
+			if (BeginFullscreenWindow("Table"))
+			{
+				const ImGuiTableFlags Flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable;
+				if (ImGui::BeginTable("Rows", 4, Flags))
+				{
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("Id");
+					ImGui::TableSetupColumn("Name");
+					ImGui::TableSetupColumn("Value");
+					ImGui::TableSetupColumn("Progress");
+					ImGui::TableHeadersRow();
+
+					// Scroll through the table, so every frame shows different rows.
+					ImGui::SetScrollY(ImGui::GetScrollMaxY() * Frame / Frames);
+
+					ImGuiListClipper Clipper;
+					Clipper.Begin(Rows);
+					while (Clipper.Step())
+					{
+						for (int32 Row = Clipper.DisplayStart; Row < Clipper.DisplayEnd; Row++)
+						{
+							ImGui::TableNextRow();
+							ImGui::TableNextColumn();
+							ImGui::Text("%d", Row);
+							ImGui::TableNextColumn();
+							ImGui::Text("Item %08X", Row * 2654435761u);
+							ImGui::TableNextColumn();
+							ImGui::Text("%.3f", FMath::Sin(Row * 0.01f));
+							ImGui::TableNextColumn();
+							ImGui::ProgressBar((Row % 100) / 100.f);
+						}
+					}
+
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+		});
+	}
+
+	int32 RunPlots(const FString& Params)
+	{
+		int32 Points = 1000000;
+		FParse::Value(*Params, TEXT("Points="), Points);
+		Points = FMath::Max(Points, 2);
+
+		TArray<float> Xs;
+		TArray<float> Ys;
+		Xs.SetNumUninitialized(Points);
+		Ys.SetNumUninitialized(Points);
+		for (int32 Idx = 0; Idx < Points; Idx++)
+		{
+			Xs[Idx] = Idx / (float)Points;
+			Ys[Idx] = FMath::Sin(Idx * 0.001f) + 0.25f * FMath::Sin(Idx * 0.37f);
+		}
+
+		return RunImGuiFrames(TEXT("Plots"), Params, [&Xs, &Ys, Points](int32 Frame, int32 Frames)
+		{
+			if (BeginFullscreenWindow("Plots"))
+			{
+				if (ImPlot::BeginPlot("Signal", { -1.f, -1.f }))
+				{
+					ImPlot::PlotLine("Line", Xs.GetData(), Ys.GetData(), Points);
+					ImPlot::EndPlot();
+				}
+			}
+			ImGui::End();
+		});
+	}
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	int32 RunFontAtlas(const FString& Params)
+	{
+		FString FontFile;
+		FString Ranges = TEXT("Default");
+		float Size = 13.f;
+		int32 Iterations = 20;
+		FParse::Value(*Params, TEXT("Font="), FontFile);
+		FParse::Value(*Params, TEXT("Ranges="), Ranges);
+		FParse::Value(*Params, TEXT("Size="), Size);
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+
+		TArray<uint8> FontData;
+		if (!FontFile.IsEmpty() && !FFileHelper::LoadFileToArray(FontData, *FontFile))
+		{
+			UE_LOG(LogImGuiBenchmark, Error, TEXT("Cannot read font file '%s'."), *FontFile);
+			return 1;
+		}
+
+		// Glyph ranges are static arrays, so we can take them from any atlas.
+		ImFontAtlas RangesAtlas;
+		const ImWchar* GlyphRanges = Ranges == TEXT("Cyrillic") ? RangesAtlas.GetGlyphRangesCyrillic()
+			: Ranges == TEXT("Japanese") ? RangesAtlas.GetGlyphRangesJapanese()
+			: Ranges == TEXT("ChineseFull") ? RangesAtlas.GetGlyphRangesChineseFull()
+			: RangesAtlas.GetGlyphRangesDefault();
+
+		auto AddFonts = [&](ImFontAtlas& Atlas)
+		{
+			ImFontConfig FontConfig;
+			FontConfig.SizePixels = Size;
+			FontConfig.GlyphRanges = GlyphRanges;
+			if (FontData.Num() > 0)
+			{
+				FontConfig.FontData = FontData.GetData();
+				FontConfig.FontDataSize = FontData.Num();
+				FontConfig.FontDataOwnedByAtlas = false;
+				Atlas.AddFont(&FontConfig);
+			}
+			else
+			{
+				Atlas.AddFontDefault(&FontConfig);
+			}
+		};
+
+		// Make sure that the cache has an entry for this setup.
+		uint64 CacheKey = 0;
+		{
+			ImFontAtlas Atlas;
+			AddFonts(Atlas);
+			if (!ImGuiFontAtlasCache::GetKey(Atlas, CacheKey) || !Atlas.Build() || !ImGuiFontAtlasCache::Save(Atlas, CacheKey))
+			{
+				UE_LOG(LogImGuiBenchmark, Error, TEXT("Cannot save font atlas in the cache."));
+				return 1;
+			}
+
+			UE_LOG(LogImGuiBenchmark, Display, TEXT("FontAtlas: '%s', size %g, %s ranges, %dx%d texture, %d iterations"),
+				FontFile.IsEmpty() ? TEXT("<default>") : *FontFile, Size, *Ranges, Atlas.TexWidth, Atlas.TexHeight, Iterations);
+		}
+
+		const FTimingResult Rasterize = Measure(Iterations, [&]()
+		{
+			ImFontAtlas Atlas;
+			AddFonts(Atlas);
+			Atlas.Build();
+		});
+
+		bool bCacheHit = true;
+		const FTimingResult CacheLoad = Measure(Iterations, [&]()
+		{
+			ImFontAtlas Atlas;
+			AddFonts(Atlas);
+			uint64 Key = 0;
+			bCacheHit &= ImGuiFontAtlasCache::GetKey(Atlas, Key) && ImGuiFontAtlasCache::Load(Atlas, Key);
+		});
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Rasterize:   min %8.3f ms, avg %8.3f ms"), Rasterize.MinSeconds * 1000.0, Rasterize.AvgSeconds * 1000.0);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Cache load:  min %8.3f ms, avg %8.3f ms%s"), CacheLoad.MinSeconds * 1000.0, CacheLoad.AvgSeconds * 1000.0,
+			bCacheHit ? TEXT("") : TEXT(" (cache misses)"));
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Speed-up:    %.2fx"), Rasterize.MinSeconds / CacheLoad.MinSeconds);
+
+		return 0;
+	}
+
+#if IMGUI_WITH_DRAW_ELEMENT
+	int32 RunDrawElement(const FString& Params)
+	{
+		int32 NumLists = 16;
+		int32 NumVertices = 20000;
+		int32 QuadsPerCommand = 64;
+		int32 Iterations = 100;
+		int32 Seed = 0;
+		FParse::Value(*Params, TEXT("Lists="), NumLists);
+		FParse::Value(*Params, TEXT("Vertices="), NumVertices);
+		FParse::Value(*Params, TEXT("QuadsPerCommand="), QuadsPerCommand);
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+
+		TArray<FImGuiDrawList> DrawLists;
+		GenerateDrawLists(DrawLists, NumLists, NumVertices, FMath::Max(QuadsPerCommand, 1), Seed);
+
+		TArray<FImGuiSlateDrawList> SlateDrawLists;
+		SlateDrawLists.SetNum(NumLists);
+
+		FImGuiRenderData RenderData;
+
+		const FTransform2D Transform{ FScale2D{ 1.25f }, FVector2D{ 13.f, 7.f } };
+		const FSlateRect CullingRect{ 0.f, 0.f, 4800.f, 2700.f };
+
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("DrawElement: %d lists, %d vertices per list, %d iterations"), NumLists, NumVertices, Iterations);
+
+		const FTimingResult SlateConversion = Measure(Iterations, [&]()
+		{
+			for (int32 Index = 0; Index < NumLists; Index++)
+			{
+				DrawLists[Index].CopyDrawData(SlateDrawLists[Index], Transform, CullingRect);
+			}
+		});
+
+		const FTimingResult RawCopy = Measure(Iterations, [&]()
+		{
+			RenderData.CopyDrawData(DrawLists);
+		});
+
+		const int32 TotalVertices = NumLists * NumVertices;
+		LogTiming(TEXT("Slate:"), SlateConversion, TotalVertices);
+		LogTiming(TEXT("Raw:"), RawCopy, TotalVertices);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Speed-up:    %.2fx"), SlateConversion.MinSeconds / RawCopy.MinSeconds);
+
+		SIZE_T SlateBytes = 0;
+		for (const FImGuiSlateDrawList& DrawList : SlateDrawLists)
+		{
+			for (const FImGuiSlateDrawBatch& Batch : DrawList.Batches)
+			{
+				SlateBytes += Batch.VertexBuffer.Num() * sizeof(FSlateVertex) + Batch.IndexBuffer.Num() * sizeof(SlateIndex);
+			}
+		}
+		const SIZE_T RawBytes = RenderData.VertexBuffer.Num() * sizeof(ImDrawVert) + RenderData.IndexBuffer.Num() * sizeof(ImDrawIdx);
+		UE_LOG(LogImGuiBenchmark, Display, TEXT("  Frame data:  Slate %.2f MB, raw %.2f MB"), SlateBytes / (1024.0 * 1024.0), RawBytes / (1024.0 * 1024.0));
+
+		return 0;
+	}
+#endif // IMGUI_WITH_DRAW_ELEMENT
+}
+
+UImGuiBenchmarkCommandlet::UImGuiBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UImGuiBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString Workload = TEXT("VertexConversion");
+	FParse::Value(*Params, TEXT("Workload="), Workload);
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	if (Workload == TEXT("VertexConversion"))
+	{
+		return RunVertexConversion(Params);
+	}
+
+	if (Workload == TEXT("TransformSpecialization"))
+	{
+		return RunTransformSpecialization(Params);
+	}
+
+	if (Workload == TEXT("Replay"))
+	{
+		return RunReplay(Params);
+	}
+
+	if (Workload == TEXT("Demo"))
+	{
+		return RunDemo(Params);
+	}
+
+	if (Workload == TEXT("Table"))
+	{
+		return RunTable(Params);
+	}
+
+	if (Workload == TEXT("Plots"))
+	{
+		return RunPlots(Params);
+	}
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	if (Workload == TEXT("FontAtlas"))
+	{
+		return RunFontAtlas(Params);
+	}
+
+#if IMGUI_WITH_DRAW_ELEMENT
+	if (Workload == TEXT("DrawElement"))
+	{
+		return RunDrawElement(Params);
+	}
+#endif // IMGUI_WITH_DRAW_ELEMENT
+
+	UE_LOG(LogImGuiBenchmark, Error, TEXT("Unknown benchmark workload '%s'."), *Workload);
+	return 1;
+}
@@ -0,0 +1,37 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+
+#include "ImGuiBenchmarkCommandlet.generated.h"
+
+
+/**
+ * Commandlet running ImGui micro-benchmarks without game world, viewport or renderer, so it can be run headless:
+ *
+ *   <Editor>-Cmd <Project> -run=ImGuiBenchmark -Workload=VertexConversion -Vertices=300000 -Iterations=100 -nullrhi
+ *
+ * Workloads:
+ *   VertexConversion - Compare vectorized and scalar ImGui to Slate vertex conversion on synthetic draw lists.
+ *   TransformSpecialization - Compare vertex conversions specialized for identity, translation and uniform scale
+ *     transforms with the general one.
+ *   DrawElement - Compare conversion to Slate format with copying raw data for the custom draw element (UE 5.3+).
+ *   Replay - Convert frames from a draw data capture (see ImGui.CaptureDrawData) to Slate format. Capture file is
+ *     passed with -File=<Path>.
+ *   Demo, Table, Plots - Run frames of the ImGui and ImPlot demo windows, a 100k-row table or a 1M-point plot in
+ *     a private context and measure NewFrame, Render, conversion to Slate format and allocations per frame.
+ *   FontAtlas - Compare rasterizing a font atlas with loading it from the font atlas cache. Font is the default one or
+ *     a TTF file passed with -Font=<Path>, with -Size=<Pixels> and -Ranges=<Default|Cyrillic|Japanese|ChineseFull>.
+ */
+UCLASS()
+class UImGuiBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UImGuiBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,178 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiContextAllocator.h"
+
+#include <HAL/UnrealMemory.h>
+#include <Math/UnrealMathUtility.h>
+#include <Misc/ScopeLock.h>
+
+
+// Header stored before every block. Its size keeps blocks aligned to 16 bytes.
+struct alignas(16) FImGuiBlockHeader
+{
+	FImGuiContextAllocator* Owner;
+	uint32 SizeClass;
+	uint32 Size;
+};
+
+namespace
+{
+	constexpr uint32 MinBlockSizeLog2 = 4;
+	constexpr uint32 LargeBlock = ~0u;
+
+	FORCEINLINE uint32 GetSizeClass(size_t Size, uint32 NumSizeClasses)
+	{
+		if (Size > (size_t(1) << (MinBlockSizeLog2 + NumSizeClasses - 1)))
+		{
+			return LargeBlock;
+		}
+
+		return FMath::CeilLogTwo(FMath::Max<uint32>(static_cast<uint32>(Size), 1u << MinBlockSizeLog2)) - MinBlockSizeLog2;
+	}
+
+	FORCEINLINE size_t GetBlockSize(uint32 SizeClass, size_t Size)
+	{
+		return SizeClass == LargeBlock ? Size : (size_t(1) << (SizeClass + MinBlockSizeLog2));
+	}
+
+	FORCEINLINE FImGuiBlockHeader* MallocBlock(size_t BlockSize)
+	{
+		return static_cast<FImGuiBlockHeader*>(FMemory::Malloc(sizeof(FImGuiBlockHeader) + BlockSize, alignof(FImGuiBlockHeader)));
+	}
+}
+
+void FImGuiContextAllocator::Release()
+{
+	bool bDestroy = false;
+	{
+		FScopeLock Lock(&CriticalSection);
+		bReleased = true;
+		TrimLocked();
+		bDestroy = (LiveBlocks == 0);
+	}
+
+	if (bDestroy)
+	{
+		delete this;
+	}
+}
+
+void FImGuiContextAllocator::Trim()
+{
+	FScopeLock Lock(&CriticalSection);
+	TrimLocked();
+}
+
+void FImGuiContextAllocator::TrimLocked()
+{
+	for (FFreeBlock*& FreeList : FreeLists)
+	{
+		while (FreeList)
+		{
+			FFreeBlock* Block = FreeList;
+			FreeList = Block->Next;
+			FMemory::Free(reinterpret_cast<FImGuiBlockHeader*>(Block) - 1);
+		}
+	}
+
+	CachedBytes = 0;
+}
+
+void FImGuiContextAllocator::EndFrame()
+{
+	LastFrameAllocations = FrameAllocations;
+	FrameAllocations = 0;
+}
+
+void* FImGuiContextAllocator::Allocate(FImGuiContextAllocator* Allocator, size_t Size)
+{
+	if (Allocator)
+	{
+		return Allocator->AllocateBlock(Size);
+	}
+
+	FImGuiBlockHeader* Header = MallocBlock(Size);
+	Header->Owner = nullptr;
+	Header->SizeClass = LargeBlock;
+	Header->Size = static_cast<uint32>(Size);
+	return Header + 1;
+}
+
+void FImGuiContextAllocator::Free(void* Ptr)
+{
+	if (Ptr)
+	{
+		FImGuiBlockHeader* Header = static_cast<FImGuiBlockHeader*>(Ptr) - 1;
+		if (Header->Owner)
+		{
+			Header->Owner->FreeBlock(Header);
+		}
+		else
+		{
+			FMemory::Free(Header);
+		}
+	}
+}
+
+void* FImGuiContextAllocator::AllocateBlock(size_t Size)
+{
+	const uint32 SizeClass = GetSizeClass(Size, NumSizeClasses);
+	const size_t BlockSize = GetBlockSize(SizeClass, Size);
+
+	FScopeLock Lock(&CriticalSection);
+
+	FImGuiBlockHeader* Header = nullptr;
+	if (SizeClass != LargeBlock && FreeLists[SizeClass])
+	{
+		FFreeBlock* Block = FreeLists[SizeClass];
+		FreeLists[SizeClass] = Block->Next;
+		CachedBytes -= BlockSize;
+		Header = reinterpret_cast<FImGuiBlockHeader*>(Block) - 1;
+	}
+	else
+	{
+		Header = MallocBlock(BlockSize);
+	}
+
+	Header->Owner = this;
+	Header->SizeClass = SizeClass;
+	Header->Size = static_cast<uint32>(Size);
+
+	LiveBytes += Size;
+	PeakBytes = FMath::Max(PeakBytes, LiveBytes);
+	LiveBlocks++;
+	FrameAllocations++;
+
+	return Header + 1;
+}
+
+void FImGuiContextAllocator::FreeBlock(FImGuiBlockHeader* Header)
+{
+	bool bDestroy = false;
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		LiveBytes -= Header->Size;
+		LiveBlocks--;
+
+		// After release, blocks are no longer cached since nobody will allocate them.
+		if (Header->SizeClass != LargeBlock && !bReleased)
+		{
+			FFreeBlock* Block = reinterpret_cast<FFreeBlock*>(Header + 1);
+			Block->Next = FreeLists[Header->SizeClass];
+			FreeLists[Header->SizeClass] = Block;
+			CachedBytes += GetBlockSize(Header->SizeClass, Header->Size);
+		}
+		else
+		{
+			FMemory::Free(Header);
+		}
+
+		bDestroy = (bReleased && LiveBlocks == 0);
+	}
+
+	if (bDestroy)
+	{
+		delete this;
+	}
+}
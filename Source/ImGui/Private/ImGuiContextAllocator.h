@@ -0,0 +1,91 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <HAL/CriticalSection.h>
+#include <HAL/Platform.h>
+
+
+struct FImGuiBlockHeader;
+
+// Allocator used by ImGui while the context, to which it is bound, is current (see
+// ImGuiImplementation::SetContextAllocator). Small blocks are allocated from size-class bins, which keep freed blocks
+// for reuse, so ImVector growth in draw lists, text buffers and tables doesn't go to the global allocator in every
+// frame. Allocator also tracks memory statistics of its context.
+//
+// Every block starts with a header pointing to its allocator, so blocks can be freed in any context. Allocator is
+// destroyed only after it is released by its owner and all of its blocks are freed.
+class FImGuiContextAllocator
+{
+public:
+
+	// Create a new allocator, which needs to be released with Release.
+	static FImGuiContextAllocator* Create() { return new FImGuiContextAllocator(); }
+
+	// Release allocator by its owner. Blocks cached in bins are freed immediately, but allocator stays alive until all
+	// its blocks are freed.
+	void Release();
+
+	// Free blocks cached in bins.
+	void Trim();
+
+	// Close per-frame statistics. Should be called once at the beginning of each frame.
+	void EndFrame();
+
+	// Get the number of bytes in blocks currently allocated from this allocator.
+	uint64 GetLiveBytes() const { return LiveBytes; }
+
+	// Get the highest number of bytes allocated from this allocator at the same time.
+	uint64 GetPeakBytes() const { return PeakBytes; }
+
+	// Get the number of bytes in freed blocks, which are cached for reuse.
+	uint64 GetCachedBytes() const { return CachedBytes; }
+
+	// Get the number of allocations made during the last frame.
+	uint32 GetFrameAllocations() const { return LastFrameAllocations; }
+
+	// Allocate a block from the allocator or from the global allocator, if allocator is null.
+	// @param Allocator - Allocator to use or null
+	// @param Size - Size of the block in bytes
+	// @returns Pointer to the allocated block
+	static void* Allocate(FImGuiContextAllocator* Allocator, size_t Size);
+
+	// Free a block allocated with Allocate, regardless of which allocator it came from.
+	// @param Ptr - Pointer to the block or null
+	static void Free(void* Ptr);
+
+private:
+
+	// Blocks of up to 16 << (NumSizeClasses - 1) bytes are allocated from bins.
+	static constexpr uint32 NumSizeClasses = 9;
+
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	FImGuiContextAllocator() = default;
+	~FImGuiContextAllocator() = default;
+
+	FImGuiContextAllocator(const FImGuiContextAllocator&) = delete;
+	FImGuiContextAllocator& operator=(const FImGuiContextAllocator&) = delete;
+
+	void* AllocateBlock(size_t Size);
+	void FreeBlock(FImGuiBlockHeader* Header);
+
+	void TrimLocked();
+
+	// Blocks are allocated and freed on the thread that updates the context, but they can be freed on a different
+	// thread when they are shared, so we keep the lock (uncontended in practice).
+	FCriticalSection CriticalSection;
+
+	FFreeBlock* FreeLists[NumSizeClasses] = {};
+
+	uint64 LiveBytes = 0;
+	uint64 PeakBytes = 0;
+	uint64 CachedBytes = 0;
+	uint32 LiveBlocks = 0;
+	uint32 FrameAllocations = 0;
+	uint32 LastFrameAllocations = 0;
+	bool bReleased = false;
+};
@@ -3,12 +3,20 @@
 #include "ImGuiContextManager.h"
 
 #include "ImGuiDelegatesContainer.h"
+#include "ImGuiDrawElement.h"
+#include "ImGuiFontAtlasCache.h"
 #include "ImGuiImplementation.h"
+#include "ImGuiModuleProperties.h"
 #include "ImGuiModuleSettings.h"
 #include "ImGuiModule.h"
 #include "Utilities/WorldContext.h"
 #include "Utilities/WorldContextIndex.h"
 
+#include <Async/Async.h>
+#include <Async/ParallelFor.h>
+#include <HAL/IConsoleManager.h>
+#include <HAL/PlatformTime.h>
+
 #include <imgui.h>
 
 // MSVC warnings
@@ -18,6 +26,56 @@
 
 // TODO: Refactor ImGui Context Manager, to handle different types of worlds.
 
+namespace CVars
+{
+	TAutoConsoleVariable<float> UpdateRate(TEXT("ImGui.UpdateRate"), -1.f,
+		TEXT("Target number of ImGui frames per second in every context. Between updates the last frame is redrawn.\n")
+		TEXT("<0: use value from ImGui settings (default)\n")
+		TEXT("0: update in every frame\n")
+		TEXT(">0: target update rate"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> AsyncFontAtlasBuild(TEXT("ImGui.AsyncFontAtlasBuild"), 1,
+		TEXT("Rebuild font atlas on a worker thread and keep using the old one until the new one is ready.\n")
+		TEXT("0: disabled\n")
+		TEXT("1: enabled (default)"),
+		ECVF_Default);
+
+#if IMGUI_WITH_DRAW_ELEMENT
+	TAutoConsoleVariable<int> AlphaFontAtlas(TEXT("ImGui.AlphaFontAtlas"), 0,
+		TEXT("Upload font atlas as a single-channel (Alpha8) texture, which takes a quarter of the memory of the RGBA\n")
+		TEXT("texture. Slate cannot render it, so while enabled, widgets render with ImGui shaders (see ImGui.CustomDrawElement).\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+#endif // IMGUI_WITH_DRAW_ELEMENT
+
+	TAutoConsoleVariable<int> FontTiers(TEXT("ImGui.FontTiers"), 1,
+		TEXT("Number of additional size tiers of the default font rasterized in the font atlas, below and above the tier\n")
+		TEXT("closest to the DPI scale. Tiers are a quarter of an octave apart and the closest one is scaled to the exact\n")
+		TEXT("size, so DPI changes use a tier from the current atlas while a new one is built in the background.\n")
+		TEXT("0: disabled, default font is rasterized at the DPI scale and every change rebuilds the atlas\n")
+		TEXT(">0: number of tiers on each side (default: 1)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> Hibernation(TEXT("ImGui.Hibernation"), 0,
+		TEXT("Stop updating contexts that have no bound debug delegates and draw nothing, until ImGui is used in them.\n")
+		TEXT("Content drawn only to the background or foreground draw lists doesn't keep contexts awake, so it disappears.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+#if WITH_EDITOR
+	TAutoConsoleVariable<int> ParallelContextTick(TEXT("ImGui.ParallelContextTick"), 0,
+		TEXT("End and begin frames of PIE contexts on worker threads. Debug delegates are still called on the game thread.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+#endif // WITH_EDITOR
+}
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiContextManager, Log, All);
+
 namespace
 {
 #if WITH_EDITOR
@@ -60,15 +118,49 @@ namespace
 	}
 
 #endif // WITH_EDITOR
+
+	constexpr float DefaultFontSize = 13.f;
+	constexpr float FontTiersPerOctave = 4.f;
+	constexpr int32 MaxFontTiers = 4;
+
+	int32 GetNumFontTiers()
+	{
+		return FMath::Clamp(CVars::FontTiers.GetValueOnAnyThread(), 0, MaxFontTiers);
+	}
+
+	// Get index of the smallest tier that is not smaller than the scale, so text is scaled down rather than up.
+	int32 GetFontTier(float Scale)
+	{
+		return FMath::CeilToInt(FontTiersPerOctave * FMath::Log2(FMath::Max(Scale, 0.1f)) - KINDA_SMALL_NUMBER);
+	}
+
+	float GetFontTierScale(int32 Tier)
+	{
+		return FMath::Pow(2.f, Tier / FontTiersPerOctave);
+	}
+
+	// Get scale at which the default font is rasterized as the first font in the atlas.
+	float GetFontAtlasScale(float DPIScale, int32 NumTiers)
+	{
+		return NumTiers > 0 ? GetFontTierScale(GetFontTier(DPIScale)) : DPIScale;
+	}
+
+	ImFont* AddDefaultFont(ImFontAtlas& Atlas, float SizePixels)
+	{
+		ImFontConfig FontConfig = {};
+		FontConfig.SizePixels = SizePixels;
+		return Atlas.AddFontDefault(&FontConfig);
+	}
 }
 
-FImGuiContextManager::FImGuiContextManager(FImGuiModuleSettings& InSettings)
+FImGuiContextManager::FImGuiContextManager(FImGuiModuleSettings& InSettings, FImGuiModuleProperties& InProperties)
 	: Settings(InSettings)
+	, Properties(InProperties)
 {
 	Settings.OnDPIScaleChangedDelegate.AddRaw(this, &FImGuiContextManager::SetDPIScale);
 
+	// Font atlas is built together with the first context (see CreateContextData).
 	SetDPIScale(Settings.GetDPIScaleInfo());
-	BuildFontAtlas();
 
 	FWorldDelegates::OnWorldTickStart.AddRaw(this, &FImGuiContextManager::OnWorldTickStart);
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
@@ -78,8 +170,17 @@ FImGuiContextManager::FImGuiContextManager(FImGuiModuleSettings& InSettings)
 
 FImGuiContextManager::~FImGuiContextManager()
 {
+	// Font atlas build task needs to finish before the atlas it is writing to is destroyed.
+	if (PendingFontAtlasBuild.IsValid())
+	{
+		PendingFontAtlasBuild.Wait();
+	}
+
 	// Early dealloc of contexts for clean shutdown order
 	Contexts.Reset();
+#if WITH_EDITOR
+	ContextPool.Empty();
+#endif
 
 	Settings.OnDPIScaleChangedDelegate.RemoveAll(this);
 
@@ -92,26 +193,107 @@ FImGuiContextManager::~FImGuiContextManager()
 
 void FImGuiContextManager::Tick(float DeltaSeconds)
 {
-	// In editor, worlds can get invalid. We could remove corresponding entries, but that would mean resetting ImGui
-	// context every time when PIE session is restarted. Instead we freeze contexts until their worlds are re-created.
+	// Swap font atlas, if it was built on a worker thread since the last tick. This happens before contexts advance, so
+	// they use the new fonts starting from the next frame.
+	UpdateFontAtlasBuild();
+
+	// Font atlas is rebuilt when DPI scale moves to a different tier or when settings baked into the atlas change.
+	// Until the new atlas is ready, contexts use the closest tier from the current one.
+	if (FontAtlas.IsBuilt() && !PendingFontAtlas && !IsFontAtlasUpToDate())
+	{
+		RebuildFontAtlas();
+	}
+
+	// Glyphs requested in the previous frame are added before contexts advance, so they are not updated while atlas
+	// is modified and can use new glyphs starting from the next frame.
+	// Contexts that don't advance keep displaying draw data from older frames, so their glyphs need to stay in the atlas.
+	uint64 OldestFrameInUse = GFrameCounter;
+	Contexts.ForEach([&OldestFrameInUse](int32, FContextData& ContextData)
+	{
+		if (ContextData.ContextProxy && !ContextData.ContextProxy->IsHibernating() && ContextData.ContextProxy->HasDrawData())
+		{
+			OldestFrameInUse = FMath::Min(OldestFrameInUse, ContextData.ContextProxy->GetDrawDataFrameCounter());
+		}
+	});
+
+	FIntRect DirtyRect;
+	if (DynamicGlyphs.Update(OldestFrameInUse, DirtyRect))
+	{
+		OnFontAtlasUpdated.Broadcast(DirtyRect);
+	}
+
+	const float UpdateRateOverride = CVars::UpdateRate.GetValueOnGameThread();
+	SetUpdateRate(UpdateRateOverride >= 0.f ? UpdateRateOverride : Settings.GetUpdateRate());
 
-	for (auto& Pair : Contexts)
+	// In editor, worlds can get invalid. Contexts of destroyed PIE worlds are moved to a pool, from which they are
+	// reused when PIE session is restarted, so we don't need to create new contexts and windows keep their state.
+
+#if WITH_EDITOR
+	// PIE contexts can be advanced in parallel after their delegates are called on the game thread.
+	const bool bParallelTick = CVars::ParallelContextTick.GetValueOnGameThread() > 0;
+	TArray<FImGuiContextProxy*, TInlineAllocator<8>> ParallelContexts;
+	TArray<int32, TInlineAllocator<8>> ContextsToRelease;
+#endif // WITH_EDITOR
+
+	NumHibernatingContexts = 0;
+
+	Contexts.ForEach([&](int32 ContextIndex, FContextData& ContextData)
 	{
-		auto& ContextData = Pair.Value;
 		if (ContextData.CanTick())
 		{
+			if (UpdateHibernation(ContextIndex, *ContextData.ContextProxy))
+			{
+				NumHibernatingContexts++;
+				return;
+			}
+
+#if WITH_EDITOR
+			if (bParallelTick && ContextData.PIEInstance >= 0)
+			{
+				if (ContextData.ContextProxy->BeginTick(DeltaSeconds))
+				{
+					ParallelContexts.Add(ContextData.ContextProxy.Get());
+				}
+				return;
+			}
+#endif // WITH_EDITOR
+
 			ContextData.ContextProxy->Tick(DeltaSeconds);
 		}
+#if WITH_EDITOR
 		else
 		{
-			// Clear to make sure that we don't store objects registered for world that is no longer valid.
-			FImGuiDelegatesContainer::Get().OnWorldDebug(Pair.Key).Clear();
+			ContextsToRelease.Add(ContextIndex);
 		}
+#endif // WITH_EDITOR
+	});
+
+#if WITH_EDITOR
+	// Contexts share only the font atlas. Its font data are only read during frame updates, but ImGui::NewFrame and
+	// EndFrame write the atlas Locked flag, so tasks race on it. That flag is only checked by asserts in functions
+	// adding fonts, which are not called while tasks run, so the race is tolerated rather than patched in ImGui. Each
+	// task uses a thread-local current context, so it doesn't affect other tasks nor the global context on the game
+	// thread. We join before returning, so widgets and delegates never see contexts in the middle of an update.
+	ParallelFor(ParallelContexts.Num(), [&](int32 Index)
+	{
+		ImGuiImplementation::FScopedThreadLocalContext ThreadLocalContext;
+		ParallelContexts[Index]->AdvanceFrame();
+	}, ParallelContexts.Num() < 2);
+
+	for (int32 ContextIndex : ContextsToRelease)
+	{
+		ReleasePIEContext(ContextIndex);
 	}
+#endif // WITH_EDITOR
 
 	// Once all context tick they should use new fonts and we can release the old resources. Extra countdown is added
-	// wait for contexts that ticked outside of this function, before rebuilding fonts.
-	if (FontResourcesReleaseCountdown > 0 && !--FontResourcesReleaseCountdown)
+	// wait for contexts that ticked outside of this function, before rebuilding fonts. Contexts with reduced update
+	// rate can keep their frames open for longer, so we also wait until all of them start a new frame.
+	if (FontResourcesReleaseCountdown > 0)
+	{
+		FontResourcesReleaseCountdown--;
+	}
+	if (FontResourcesReleaseCountdown == 0 && FontResourcesToRelease.Num() > 0 && CanReleaseFontResources())
 	{
 		FontResourcesToRelease.Empty();
 	}
@@ -126,7 +308,7 @@ void FImGuiContextManager::OnWorldTickStart(ELevelTick TickType, float DeltaSeco
 
 void FImGuiContextManager::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
 {
-	if (World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
+	if (World && IsActive() && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
 		|| World->WorldType == EWorldType::Editor))
 	{
 		FImGuiContextProxy& ContextProxy = GetWorldContextProxy(*World);
@@ -144,7 +326,7 @@ void FImGuiContextManager::OnWorldTickStart(UWorld* World, ELevelTick TickType,
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
 void FImGuiContextManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
 {
-	if (World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
+	if (World && IsActive() && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
 		|| World->WorldType == EWorldType::Editor))
 	{
 		GetWorldContextProxy(*World).DrawDebug();
@@ -152,6 +334,23 @@ void FImGuiContextManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickTy
 }
 #endif // ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
 
+FImGuiContextManager::FContextData FImGuiContextManager::CreateContextData(const FString& ContextName, int32 ContextIndex, int32 PIEInstance)
+{
+	// Contexts are not destroyed until shutdown, so from now on manager stays active.
+	bActive = true;
+
+	// Building font atlas is delayed until it is needed, so sessions without ImGui don't pay for it.
+	BuildFontAtlas();
+
+	const double StartTime = FPlatformTime::Seconds();
+	FContextData Data{ ContextName, ContextIndex, FontAtlas, DPIScale, UpdateRate, PIEInstance };
+	Data.ContextProxy->SetDefaultFont(DefaultFont);
+	UE_LOG(LogImGuiContextManager, Log, TEXT("Created ImGui context '%s' in %.2f ms."), *ContextName,
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return Data;
+}
+
 #if WITH_EDITOR
 FImGuiContextManager::FContextData& FImGuiContextManager::GetEditorContextData()
 {
@@ -159,12 +358,58 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetEditorContextData()
 
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Utilities::EDITOR_CONTEXT_INDEX, FContextData{ GetEditorContextName(), Utilities::EDITOR_CONTEXT_INDEX, FontAtlas, DPIScale, -1 });
+		Data = &Contexts.Emplace(Utilities::EDITOR_CONTEXT_INDEX, CreateContextData(GetEditorContextName(), Utilities::EDITOR_CONTEXT_INDEX));
 		OnContextProxyCreated.Broadcast(Utilities::EDITOR_CONTEXT_INDEX, *Data->ContextProxy);
 	}
 
 	return *Data;
 }
+
+FImGuiContextManager::FContextData FImGuiContextManager::MakePIEContextData(const FString& ContextName, int32 ContextIndex, int32 PIEInstance)
+{
+	// Prefer the context last used with the same index, as it has the same settings and windows as in the previous
+	// session. Otherwise, any pooled context will do, since they all share the same font atlas.
+	int32 PoolIndex = ContextPool.IndexOfByPredicate([ContextIndex](const TUniquePtr<FImGuiContextProxy>& ContextProxy)
+	{
+		return ContextProxy->GetContextIndex() == ContextIndex;
+	});
+
+	if (PoolIndex == INDEX_NONE)
+	{
+		PoolIndex = ContextPool.Num() - 1;
+	}
+
+	if (PoolIndex == INDEX_NONE)
+	{
+		return CreateContextData(ContextName, ContextIndex, PIEInstance);
+	}
+
+	TUniquePtr<FImGuiContextProxy> ContextProxy = MoveTemp(ContextPool[PoolIndex]);
+	ContextPool.RemoveAtSwap(PoolIndex);
+
+	// Pooled contexts don't receive module-wide updates, so we need to apply them now. Default font is set first, so
+	// the frame started by Reuse already uses it.
+	ContextProxy->SetDefaultFont(DefaultFont);
+	ContextProxy->Reuse(ContextName, ContextIndex);
+	ContextProxy->SetDPIScale(DPIScale);
+	ContextProxy->SetUpdateRate(UpdateRate);
+
+	return FContextData{ MoveTemp(ContextProxy), PIEInstance };
+}
+
+void FImGuiContextManager::ReleasePIEContext(int32 ContextIndex)
+{
+	if (FContextData* Data = Contexts.Find(ContextIndex))
+	{
+		// Remove delegates and flags to make sure that we don't store objects registered for world that is no longer
+		// valid and that the next session using this index doesn't inherit static content or redraw requests.
+		FImGuiDelegatesContainer::Get().RemoveContext(ContextIndex);
+
+		Data->ContextProxy->Release();
+		ContextPool.Add(MoveTemp(Data->ContextProxy));
+		Contexts.Remove(ContextIndex);
+	}
+}
 #endif // WITH_EDITOR
 
 #if !WITH_EDITOR
@@ -174,7 +419,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetStandaloneWorldCont
 
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Utilities::STANDALONE_GAME_CONTEXT_INDEX, FContextData{ GetWorldContextName(), Utilities::STANDALONE_GAME_CONTEXT_INDEX, FontAtlas, DPIScale });
+		Data = &Contexts.Emplace(Utilities::STANDALONE_GAME_CONTEXT_INDEX, CreateContextData(GetWorldContextName(), Utilities::STANDALONE_GAME_CONTEXT_INDEX));
 		OnContextProxyCreated.Broadcast(Utilities::STANDALONE_GAME_CONTEXT_INDEX, *Data->ContextProxy);
 	}
 
@@ -216,7 +461,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 #if WITH_EDITOR
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Index, FContextData{ GetWorldContextName(World), Index, FontAtlas, DPIScale, WorldContext->PIEInstance });
+		Data = &Contexts.Emplace(Index, MakePIEContextData(GetWorldContextName(World), Index, WorldContext->PIEInstance));
 		OnContextProxyCreated.Broadcast(Index, *Data->ContextProxy);
 	}
 	else
@@ -227,7 +472,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 #else
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Index, FContextData{ GetWorldContextName(World), Index, FontAtlas, DPIScale });
+		Data = &Contexts.Emplace(Index, CreateContextData(GetWorldContextName(World), Index));
 		OnContextProxyCreated.Broadcast(Index, *Data->ContextProxy);
 	}
 #endif
@@ -239,6 +484,33 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 	return *Data;
 }
 
+bool FImGuiContextManager::UpdateHibernation(int32 ContextIndex, FImGuiContextProxy& ContextProxy)
+{
+	// Context can be used by delegates, by calls made directly during world tick (which draw to the open frame), by
+	// module's demo or by input. Other sources, like debug widgets, can request a redraw.
+	const bool bIsUsed = FImGuiDelegatesContainer::Get().HasBoundDelegates(ContextIndex) || ContextProxy.HasWindowsInFrame()
+		|| ContextProxy.IsRedrawRequested() || Properties.IsInputEnabled() || Properties.ShowDemo();
+
+	if (ContextProxy.IsHibernating())
+	{
+		if (bIsUsed || CVars::Hibernation.GetValueOnGameThread() <= 0)
+		{
+			ContextProxy.WakeUp();
+			return false;
+		}
+
+		return true;
+	}
+
+	if (!bIsUsed && !ContextProxy.HasDrawData() && CVars::Hibernation.GetValueOnGameThread() > 0)
+	{
+		ContextProxy.Hibernate();
+		return true;
+	}
+
+	return false;
+}
+
 void FImGuiContextManager::SetDPIScale(const FImGuiDPIScaleInfo& ScaleInfo)
 {
 	const float Scale = ScaleInfo.GetImGuiScale();
@@ -246,49 +518,188 @@ void FImGuiContextManager::SetDPIScale(const FImGuiDPIScaleInfo& ScaleInfo)
 	{
 		DPIScale = Scale;
 
-		// Only rebuild font atlas if it is already built. Otherwise allow the other logic to pick a moment.
-		if (FontAtlas.IsBuilt())
-		{
-			RebuildFontAtlas();
-		}
+		// Scale changes don't rebuild font atlas immediately. Instead, contexts switch to the closest font tier and
+		// atlas is rebuilt in the next tick, if needed (see IsFontAtlasUpToDate).
+		UpdateDefaultFont();
 
-		for (auto& Pair : Contexts)
+		Contexts.ForEach([this](int32, FContextData& ContextData)
 		{
-			if (Pair.Value.ContextProxy)
+			if (ContextData.ContextProxy)
 			{
-				Pair.Value.ContextProxy->SetDPIScale(DPIScale);
+				ContextData.ContextProxy->SetDPIScale(DPIScale);
 			}
-		}
+		});
 	}
 }
 
-void FImGuiContextManager::BuildFontAtlas(const TMap<FName, TSharedPtr<ImFontConfig>>& CustomFontConfigs)
+void FImGuiContextManager::SetUpdateRate(float Rate)
 {
-	if (!FontAtlas.IsBuilt())
+	// Module-wide rate is applied to all contexts only when it changes, so it doesn't override rates set individually
+	// for contexts in the meantime.
+	if (UpdateRate != Rate)
 	{
-		ImFontConfig FontConfig = {};
-		FontConfig.SizePixels = FMath::RoundFromZero(13.f * DPIScale);
-		FontAtlas.AddFontDefault(&FontConfig);
+		UpdateRate = Rate;
 
-		// Build custom fonts
-		for (const TPair<FName, TSharedPtr<ImFontConfig>>& CustomFontPair : CustomFontConfigs)
+		Contexts.ForEach([this](int32, FContextData& ContextData)
 		{
-			FName CustomFontName = CustomFontPair.Key;
-			TSharedPtr<ImFontConfig> CustomFontConfig = CustomFontPair.Value;
-
-			// Set font name for debugging
-			if (CustomFontConfig.IsValid())
+			if (ContextData.ContextProxy)
 			{
-				strncpy(CustomFontConfig->Name, TCHAR_TO_ANSI(*CustomFontName.ToString()), 40);
+				ContextData.ContextProxy->SetUpdateRate(UpdateRate);
 			}
+		});
+	}
+}
+
+bool FImGuiContextManager::UseAlphaFontAtlas()
+{
+#if IMGUI_WITH_DRAW_ELEMENT
+	return CVars::AlphaFontAtlas.GetValueOnAnyThread() > 0;
+#else
+	return false;
+#endif
+}
+
+FImGuiContextManager::FFontLayout FImGuiContextManager::AddFonts(ImFontAtlas& Atlas, const TMap<FName, TSharedPtr<ImFontConfig>>& CustomFontConfigs) const
+{
+	// Font atlas is shared, so its allocations shouldn't be charged to the context that is current on this thread.
+	ImGuiImplementation::FScopedThreadLocalContext ThreadLocalContext;
+
+	FFontLayout Layout;
+	Layout.NumTiers = GetNumFontTiers();
+	Layout.Scale = GetFontAtlasScale(DPIScale, Layout.NumTiers);
+
+	// Default font at the closest tier stays the first font, so it is used by default and custom fonts merged into it
+	// work like before.
+	const int32 Tier = GetFontTier(Layout.Scale);
+
+	// Tier sizes are rounded up, so the selected tier is never scaled up.
+	const auto AddTier = [&](float Scale)
+	{
+		if (Layout.NumTiers > 0)
+		{
+			const float SizePixels = FMath::CeilToFloat(DefaultFontSize * Scale - KINDA_SMALL_NUMBER);
+			Layout.Tiers.Add({ AddDefaultFont(Atlas, SizePixels), SizePixels / DefaultFontSize });
+		}
+		else
+		{
+			Layout.Tiers.Add({ AddDefaultFont(Atlas, FMath::RoundFromZero(DefaultFontSize * Scale)), Scale });
+		}
+	};
+	AddTier(Layout.Scale);
+	ImFont* const AtlasScaleFont = Layout.Tiers.Last().Font;
+
+	// Build custom fonts
+	for (const TPair<FName, TSharedPtr<ImFontConfig>>& CustomFontPair : CustomFontConfigs)
+	{
+		// Fonts in merge mode are merged into the previous font, so only the leading ones merge into the tier.
+		if (Atlas.Fonts.Size == 1 && CustomFontPair.Value.IsValid() && CustomFontPair.Value->MergeMode)
+		{
+			Layout.MergedTierFont = AtlasScaleFont;
+		}
+
+		FName CustomFontName = CustomFontPair.Key;
+		TSharedPtr<ImFontConfig> CustomFontConfig = CustomFontPair.Value;
+
+		// Set font name for debugging
+		if (CustomFontConfig.IsValid())
+		{
+			strncpy(CustomFontConfig->Name, TCHAR_TO_ANSI(*CustomFontName.ToString()), 40);
+		}
+
+		ImFont* font{Atlas.AddFont(CustomFontConfig.Get())};
+		font->ContainerAtlas = &Atlas;
+	}
+
+	// Other tiers are added after custom fonts, so they don't change indices of those fonts.
+	for (int32 Offset = 1; Offset <= Layout.NumTiers; Offset++)
+	{
+		AddTier(GetFontTierScale(Tier - Offset));
+		AddTier(GetFontTierScale(Tier + Offset));
+	}
+	Layout.Tiers.Sort([](const FFontTier& A, const FFontTier& B) { return A.Scale < B.Scale; });
+
+	FImGuiDynamicGlyphs::ReserveRegion(Atlas);
+
+	return Layout;
+}
+
+bool FImGuiContextManager::IsFontAtlasUpToDate() const
+{
+	const int32 NumTiers = GetNumFontTiers();
+	return FontLayout.NumTiers == NumTiers && FontLayout.Scale == GetFontAtlasScale(DPIScale, NumTiers)
+		&& FImGuiDynamicGlyphs::MatchesSettings(FontAtlas);
+}
+
+void FImGuiContextManager::UpdateDefaultFont()
+{
+	// Tier with merged custom fonts is kept, even if it needs to be scaled up, as other tiers would show missing glyphs.
+	const FFontTier* Selected = FontLayout.Tiers.FindByPredicate([this](const FFontTier& Tier)
+	{
+		return FontLayout.MergedTierFont ? Tier.Font == FontLayout.MergedTierFont : Tier.Scale >= DPIScale - KINDA_SMALL_NUMBER;
+	});
+	if (!Selected && FontLayout.Tiers.Num() > 0)
+	{
+		Selected = &FontLayout.Tiers.Last();
+	}
+
+	// Fonts are shared by all contexts, which use the same DPI scale, so the selected tier can be scaled to the exact
+	// size without re-rasterizing.
+	for (const FFontTier& Tier : FontLayout.Tiers)
+	{
+		Tier.Font->Scale = (&Tier == Selected && FontLayout.NumTiers > 0) ? DPIScale / Tier.Scale : 1.f;
+	}
 
-			ImFont* font{FontAtlas.AddFont(CustomFontConfig.Get())};
-			font->ContainerAtlas = &FontAtlas;
+	DefaultFont = Selected ? Selected->Font : nullptr;
+
+	Contexts.ForEach([this](int32, FContextData& ContextData)
+	{
+		if (ContextData.ContextProxy)
+		{
+			ContextData.ContextProxy->SetDefaultFont(DefaultFont);
 		}
+	});
+}
 
-		unsigned char* Pixels;
-		int Width, Height, Bpp;
-		FontAtlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+void FImGuiContextManager::BuildFontAtlasTexData(ImFontAtlas& Atlas)
+{
+	// Font atlas is shared and can be built on a worker thread, so its allocations shouldn't read or be charged to the
+	// context that is current on the game thread.
+	ImGuiImplementation::FScopedThreadLocalContext ThreadLocalContext;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Rasterizing fonts is the most expensive part, so if possible we load the atlas from the cache.
+	uint64 CacheKey = 0;
+	const bool bCacheable = ImGuiFontAtlasCache::IsEnabled() && ImGuiFontAtlasCache::GetKey(Atlas, CacheKey);
+	const bool bCached = bCacheable && ImGuiFontAtlasCache::Load(Atlas, CacheKey);
+
+	// Alpha8 is the format produced by the builder. RGBA32 data are converted from it only if needed by the texture.
+	unsigned char* Pixels;
+	int Width, Height, Bpp;
+	Atlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height, &Bpp);
+	if (!UseAlphaFontAtlas())
+	{
+		Atlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+	}
+
+	UE_LOG(LogImGuiContextManager, Log, TEXT("%s font atlas with %d fonts: %dx%d texture (%d KB) in %.2f ms%s."),
+		bCached ? TEXT("Loaded cached") : TEXT("Built"), Atlas.Fonts.Size, Width, Height, Width * Height * Bpp / 1024,
+		(FPlatformTime::Seconds() - StartTime) * 1000.0, IsInGameThread() ? TEXT("") : TEXT(" on a worker thread"));
+
+	if (bCacheable && !bCached)
+	{
+		ImGuiFontAtlasCache::Save(Atlas, CacheKey);
+	}
+}
+
+void FImGuiContextManager::BuildFontAtlas(const TMap<FName, TSharedPtr<ImFontConfig>>& CustomFontConfigs)
+{
+	if (!FontAtlas.IsBuilt())
+	{
+		FontLayout = AddFonts(FontAtlas, CustomFontConfigs);
+		BuildFontAtlasTexData(FontAtlas);
+		DynamicGlyphs.Bind(FontAtlas);
+		UpdateDefaultFont();
 
 		OnFontAtlasBuilt.Broadcast();
 	}
@@ -296,16 +707,118 @@ void FImGuiContextManager::BuildFontAtlas(const TMap<FName, TSharedPtr<ImFontCon
 
 void FImGuiContextManager::RebuildFontAtlas()
 {
-	if (FontAtlas.IsBuilt())
+	// Without the old atlas, there is nothing to render with while waiting for the new one.
+	if (!FontAtlas.IsBuilt())
+	{
+		BuildFontAtlas(FImGuiModule::Get().GetProperties().GetCustomFonts());
+		return;
+	}
+
+	// Font settings might have changed since the pending build started, so we need to build again once it is done.
+	if (PendingFontAtlas)
+	{
+		bFontAtlasRebuildRequested = true;
+		return;
+	}
+
+	// Fonts are added on the game thread, so only the new atlas is accessed by the build task.
+	PendingFontAtlas = MakeUnique<ImFontAtlas>();
+	PendingFontLayout = AddFonts(*PendingFontAtlas, FImGuiModule::Get().GetProperties().GetCustomFonts());
+
+	if (CVars::AsyncFontAtlasBuild.GetValueOnGameThread() > 0)
+	{
+		ImFontAtlas* Atlas = PendingFontAtlas.Get();
+		PendingFontAtlasBuild = Async(EAsyncExecution::ThreadPool, [Atlas]()
+		{
+			BuildFontAtlasTexData(*Atlas);
+		});
+	}
+	else
+	{
+		BuildFontAtlasTexData(*PendingFontAtlas);
+		SwapFontAtlas();
+	}
+}
+
+void FImGuiContextManager::UpdateFontAtlasBuild()
+{
+	if (PendingFontAtlas && PendingFontAtlasBuild.IsValid() && PendingFontAtlasBuild.IsReady())
 	{
-		// Keep the old resources alive for a few frames to give all contexts a chance to bind to new ones.
-		FontResourcesToRelease.Add(TUniquePtr<ImFontAtlas>(new ImFontAtlas()));
-		Swap(*FontResourcesToRelease.Last(), FontAtlas);
+		PendingFontAtlasBuild.Reset();
+		SwapFontAtlas();
 
-		// Typically, one frame should be enough but since we allow for custom ticking, we need at least to frames to
-		// wait for contexts that already ticked and will not do that before the end of the next tick of this manager.
-		FontResourcesReleaseCountdown = 3;
+		if (bFontAtlasRebuildRequested)
+		{
+			bFontAtlasRebuildRequested = false;
+			RebuildFontAtlas();
+		}
 	}
+}
+
+bool FImGuiContextManager::CanReleaseFontResources() const
+{
+	// Hibernating and pooled contexts restart their frames when fonts are swapped, while other contexts need to start
+	// a new frame after that. Contexts that cannot tick are released before they are used again.
+	bool bCanRelease = true;
+	Contexts.ForEach([&bCanRelease](int32, const FContextData& ContextData)
+	{
+		if (ContextData.ContextProxy && ContextData.CanTick() && ContextData.ContextProxy->UsesReplacedFonts())
+		{
+			bCanRelease = false;
+		}
+	});
+	return bCanRelease;
+}
+
+void FImGuiContextManager::SwapFontAtlas()
+{
+	// Contexts keep pointer to the font atlas, so we swap content and keep the old resources alive for a few frames to
+	// give all contexts a chance to bind to new ones.
+	TUniquePtr<ImFontAtlas> OldFontAtlas = MoveTemp(PendingFontAtlas);
+	Swap(*OldFontAtlas, FontAtlas);
+
+	// Fonts point to their atlases, so they need to follow the swapped content.
+	for (ImFont* Font : FontAtlas.Fonts)
+	{
+		Font->ContainerAtlas = &FontAtlas;
+	}
+	for (ImFont* Font : OldFontAtlas->Fonts)
+	{
+		Font->ContainerAtlas = OldFontAtlas.Get();
+	}
+
+	FontResourcesToRelease.Add(MoveTemp(OldFontAtlas));
+	DynamicGlyphs.Bind(FontAtlas);
+
+	// Contexts switch to the default font from the new atlas before they start the next frame.
+	FontLayout = MoveTemp(PendingFontLayout);
+	UpdateDefaultFont();
+
+	// Contexts that are not ticked keep their frames open with fonts from the old atlas, so we need to restart them
+	// before the old resources are released. Other contexts are asked to start a new frame as soon as possible, even
+	// if they are idle or have a reduced update rate.
+	Contexts.ForEach([](int32, FContextData& ContextData)
+	{
+		if (ContextData.ContextProxy->IsHibernating())
+		{
+			ContextData.ContextProxy->RestartFrame();
+		}
+		else
+		{
+			ContextData.ContextProxy->OnFontsReplaced();
+		}
+	});
+#if WITH_EDITOR
+	for (const TUniquePtr<FImGuiContextProxy>& ContextProxy : ContextPool)
+	{
+		ContextProxy->SetDefaultFont(DefaultFont);
+		ContextProxy->RestartFrame();
+	}
+#endif
+
+	// Typically, one frame should be enough but since we allow for custom ticking, we need at least to frames to
+	// wait for contexts that already ticked and will not do that before the end of the next tick of this manager.
+	FontResourcesReleaseCountdown = 3;
 
-	BuildFontAtlas(FImGuiModule::Get().GetProperties().GetCustomFonts());
+	OnFontAtlasBuilt.Broadcast();
 }
@@ -3,9 +3,14 @@
 #pragma once
 
 #include "ImGuiContextProxy.h"
+#include "ImGuiDynamicGlyphs.h"
+#include "Utilities/ContextSlotArray.h"
 #include "VersionCompatibility.h"
 
+#include <Async/Future.h>
 
+
+class FImGuiModuleProperties;
 class FImGuiModuleSettings;
 struct FImGuiDPIScaleInfo;
 
@@ -17,12 +22,16 @@ struct FImGuiDPIScaleInfo;
 // @param ContextProxy - Created context proxy
 DECLARE_MULTICAST_DELEGATE_TwoParams(FContextProxyCreatedDelegate, int32, FImGuiContextProxy&);
 
+// Delegate called when a part of the font atlas texture data is modified without rebuilding the atlas.
+// @param DirtyRect - Modified part of the atlas texture
+DECLARE_MULTICAST_DELEGATE_OneParam(FFontAtlasUpdatedDelegate, const FIntRect&);
+
 // Manages ImGui context proxies.
 class FImGuiContextManager
 {
 public:
 
-	FImGuiContextManager(FImGuiModuleSettings& InSettings);
+	FImGuiContextManager(FImGuiModuleSettings& InSettings, FImGuiModuleProperties& InProperties);
 
 	FImGuiContextManager(const FImGuiContextManager&) = delete;
 	FImGuiContextManager& operator=(const FImGuiContextManager&) = delete;
@@ -35,6 +44,26 @@ public:
 	ImFontAtlas& GetFontAtlas() { return FontAtlas; }
 	const ImFontAtlas& GetFontAtlas() const { return FontAtlas; }
 
+	// Check whether font atlas should be uploaded as a single-channel texture (see 'ImGui.AlphaFontAtlas'). It is only
+	// supported with ImGui shaders, which are needed to render it.
+	static bool UseAlphaFontAtlas();
+
+	// Whether contexts are created for ticking worlds. With lazy initialization, manager is inactive until it is
+	// activated or the first context is created.
+	bool IsActive() const { return bActive || !Settings.UseLazyInitialization(); }
+
+	// Start creating contexts for ticking worlds.
+	void Activate() { bActive = true; }
+
+	// Get glyphs added to the font atlas on demand.
+	const FImGuiDynamicGlyphs& GetDynamicGlyphs() const { return DynamicGlyphs; }
+
+	// Request glyphs for characters in UTF-8 text, if they are not in the font atlas (see 'ImGui.DynamicGlyphs').
+	void RequestGlyphs(const char* Text, const char* TextEnd = nullptr) { DynamicGlyphs.Request(Text, TextEnd); }
+
+	// Get the number of contexts that were hibernating during the last tick.
+	int32 GetNumHibernatingContexts() const { return NumHibernatingContexts; }
+
 #if WITH_EDITOR
 	// Get or create editor ImGui context proxy.
 	FORCEINLINE FImGuiContextProxy& GetEditorContextProxy() { return *GetEditorContextData().ContextProxy; }
@@ -58,23 +87,67 @@ public:
 		return Data ? Data->ContextProxy.Get() : nullptr;
 	}
 
+	// Get context proxy by handle, or null if context pointed by that handle doesn't exist.
+	FORCEINLINE FImGuiContextProxy* GetContextProxy(const Utilities::FContextSlotHandle& ContextHandle)
+	{
+		FContextData* Data = Contexts.Find(ContextHandle);
+		return Data ? Data->ContextProxy.Get() : nullptr;
+	}
+
+	// Get a handle, which can be cached to quickly access context with given index, or invalid handle if context with
+	// that index doesn't exist.
+	FORCEINLINE Utilities::FContextSlotHandle GetContextHandle(int32 ContextIndex) const { return Contexts.GetHandle(ContextIndex); }
+
 	// Delegate called when a new context proxy is created.
 	FContextProxyCreatedDelegate OnContextProxyCreated;
 
-	// Delegate called after font atlas is built.
+	// Delegate called after font atlas is built. When atlas is rebuilt on a worker thread, it is called on the game
+	// thread, after the new atlas replaces the old one.
 	FSimpleMulticastDelegate OnFontAtlasBuilt;
 
+	// Delegate called after dynamic glyphs are added to or evicted from the font atlas.
+	FFontAtlasUpdatedDelegate OnFontAtlasUpdated;
+
 	void Tick(float DeltaSeconds);
 
+	// Rebuild font atlas. Unless disabled with 'ImGui.AsyncFontAtlasBuild', the new atlas is built on a worker thread
+	// and swapped at the beginning of the first tick after it is ready. Until then, contexts use the old atlas.
 	void RebuildFontAtlas();
 
 private:
 
+	// Default font rasterized at one of the size tiers.
+	struct FFontTier
+	{
+		ImFont* Font = nullptr;
+		float Scale = 1.f;
+	};
+
+	// Default font tiers in the atlas and settings used to build it.
+	struct FFontLayout
+	{
+		// Tiers sorted by scale.
+		TArray<FFontTier> Tiers;
+		float Scale = 0.f;
+		int32 NumTiers = 0;
+
+		// Tier built for the atlas scale, if custom fonts are merged into it. Other tiers lack merged glyphs, so this
+		// one is scaled to the DPI scale until the atlas is rebuilt.
+		ImFont* MergedTierFont = nullptr;
+	};
+
 	struct FContextData
 	{
-		FContextData(const FString& ContextName, int32 ContextIndex, ImFontAtlas& FontAtlas, float DPIScale, int32 InPIEInstance = -1)
+		FContextData(const FString& ContextName, int32 ContextIndex, ImFontAtlas& FontAtlas, float DPIScale, float UpdateRate, int32 InPIEInstance = -1)
 			: PIEInstance(InPIEInstance)
 			, ContextProxy(new FImGuiContextProxy(ContextName, ContextIndex, &FontAtlas, DPIScale))
+		{
+			ContextProxy->SetUpdateRate(UpdateRate);
+		}
+
+		FContextData(TUniquePtr<FImGuiContextProxy>&& InContextProxy, int32 InPIEInstance)
+			: PIEInstance(InPIEInstance)
+			, ContextProxy(MoveTemp(InContextProxy))
 		{
 		}
 
@@ -93,8 +166,16 @@ private:
 	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
 #endif
 
+	FContextData CreateContextData(const FString& ContextName, int32 ContextIndex, int32 PIEInstance = -1);
+
 #if WITH_EDITOR
 	FContextData& GetEditorContextData();
+
+	// Create data for PIE context, reusing a pooled context proxy if there is one.
+	FContextData MakePIEContextData(const FString& ContextName, int32 ContextIndex, int32 PIEInstance);
+
+	// Move PIE context, whose world was destroyed, to the pool.
+	void ReleasePIEContext(int32 ContextIndex);
 #endif
 
 #if !WITH_EDITOR
@@ -103,16 +184,45 @@ private:
 
 	FContextData& GetWorldContextData(const UWorld& World, int32* OutContextIndex = nullptr);
 
+	bool UpdateHibernation(int32 ContextIndex, FImGuiContextProxy& ContextProxy);
+
 	void SetDPIScale(const FImGuiDPIScaleInfo& ScaleInfo);
+	void SetUpdateRate(float Rate);
 	void BuildFontAtlas(const TMap<FName, TSharedPtr<ImFontConfig>>& CustomFontConfigs = {});
+	FFontLayout AddFonts(ImFontAtlas& Atlas, const TMap<FName, TSharedPtr<ImFontConfig>>& CustomFontConfigs) const;
+	bool IsFontAtlasUpToDate() const;
+	bool CanReleaseFontResources() const;
+	void UpdateDefaultFont();
+	static void BuildFontAtlasTexData(ImFontAtlas& Atlas);
+	void UpdateFontAtlasBuild();
+	void SwapFontAtlas();
+
+	Utilities::TContextSlotArray<FContextData> Contexts;
 
-	TMap<int32, FContextData> Contexts;
+#if WITH_EDITOR
+	// Context proxies released after their PIE worlds were destroyed, ready to be reused in the next PIE session.
+	TArray<TUniquePtr<FImGuiContextProxy>> ContextPool;
+#endif
 
 	ImFontAtlas FontAtlas;
+	FFontLayout FontLayout;
+	ImFont* DefaultFont = nullptr;
 	TArray<TUniquePtr<ImFontAtlas>> FontResourcesToRelease;
 
+	// Font atlas, which is being built to replace the current one.
+	TUniquePtr<ImFontAtlas> PendingFontAtlas;
+	FFontLayout PendingFontLayout;
+	TFuture<void> PendingFontAtlasBuild;
+	bool bFontAtlasRebuildRequested = false;
+
+	FImGuiDynamicGlyphs DynamicGlyphs;
+
 	FImGuiModuleSettings& Settings;
+	FImGuiModuleProperties& Properties;
 
 	float DPIScale = -1.f;
+	float UpdateRate = 0.f;
 	int32 FontResourcesReleaseCountdown = 0;
+	int32 NumHibernatingContexts = 0;
+	bool bActive = false;
 };
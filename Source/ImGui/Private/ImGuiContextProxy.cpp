@@ -2,22 +2,51 @@
 
 #include "ImGuiContextProxy.h"
 
+#include "ImGuiContextAllocator.h"
 #include "ImGuiDelegatesContainer.h"
+#include "ImGuiDrawDataCapture.h"
 #include "ImGuiImplementation.h"
 #include "ImGuiInteroperability.h"
 #include "Utilities/Arrays.h"
 #include "VersionCompatibility.h"
 
-// Include ImPlot here so we can call `ImPlot::CreateContext`
-#include <implot.h>
+// For ImGui::ClearIniSettings
+#include <imgui_internal.h>
 
+#include <Async/ParallelFor.h>
 #include <GenericPlatform/GenericPlatformFile.h>
+#include <HAL/IConsoleManager.h>
 #include <Misc/Paths.h>
 
 
 static constexpr float DEFAULT_CANVAS_WIDTH = 3840.f;
 static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
 
+// Time after the last input or redraw request, during which context keeps updating to let ImGui finish transitions
+// like fading, auto-resizing or tooltip delays, before it can become idle.
+static constexpr float IDLE_DELAY_SECONDS = 0.5f;
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> ParallelDrawListConversion(TEXT("ImGui.ParallelDrawListConversion"), 0,
+		TEXT("Convert large draw lists to Slate format on worker threads.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> ParallelDrawListMinVertices(TEXT("ImGui.ParallelDrawListConversion.MinVertices"), 8192,
+		TEXT("Minimal number of vertices in a draw list to convert it on a worker thread, when parallel conversion is enabled."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> CaptureDrawData(TEXT("ImGui.CaptureDrawData"), 0,
+		TEXT("Capture draw data of every ImGui context to files in Saved/ImGui/Captures, which can be replayed with the ImGuiBenchmark commandlet.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+}
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiDrawDataCapture, Log, All);
+
 
 namespace
 {
@@ -81,11 +110,16 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 	, ContextIndex(InContextIndex)
 	, IniFilename(TCHAR_TO_ANSI(*GetIniFile(InName)))
 {
-	// Create context.
-	Context = ImGui::CreateContext(InFontAtlas);
+	// Create context. ImPlot context is created on the first use (see ImGuiImplementation::GetPlotContext). Context
+	// doesn't have its allocator yet, so we make sure that it isn't allocated by the allocator of the current context.
+	{
+		ImGuiImplementation::FScopedThreadLocalContext ThreadLocalContext;
+		Context = ImGui::CreateContext(InFontAtlas);
+	}
 
-	// Create ImPlot context
-	ImPlot::CreateContext();
+	// Use own allocator for everything allocated in this context after creation.
+	Allocator = FImGuiContextAllocator::Create();
+	ImGuiImplementation::SetContextAllocator(Context, Allocator);
 
 	// Set this context in ImGui for initialization (any allocations will be tracked in this context).
 	SetAsCurrent();
@@ -97,6 +131,9 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 	// Set session data storage.
 	IO.IniFilename = IniFilename.c_str();
 
+	// Draw commands can be rendered with vertex offsets, which allows large meshes with 16-bit indices.
+	IO.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
 	// Start with the default canvas size.
 	ResetDisplaySize();
 	IO.DisplaySize = {(float)DisplaySize.X, (float)DisplaySize.Y};
@@ -123,12 +160,233 @@ FImGuiContextProxy::~FImGuiContextProxy()
 		// Ensure frame has ended
 		EndFrame();
 
+		// Destroy ImPlot context, if it was used.
+		ImGuiImplementation::DestroyPlotContext(Context);
+
 		// Save context data and destroy.
+		ImGuiImplementation::SetContextAllocator(Context, nullptr);
 		ImGui::DestroyContext(Context);
 
-		// Destroy ImPlot context
-		ImPlot::DestroyContext();
+		// Allocator will be destroyed after blocks still used by this proxy, like draw lists, are freed.
+		Allocator->Release();
+	}
+}
+
+void FImGuiContextProxy::Release()
+{
+	FGuardCurrentContext GuardContext;
+	SetAsCurrent();
+
+	// Save settings now, as the context might be reused under a different name.
+	ImGui::SaveIniSettingsToDisk(IniFilename.c_str());
+
+	// Release keys and buttons that were held when the session ended.
+	ImGuiIO& IO = ImGui::GetIO();
+	IO.ClearEventsQueue();
+	IO.ClearInputKeys();
+	IO.ClearInputMouse();
+	InputState.Reset();
+
+	// Finish capture and the frame opened in the last session, so nothing drawn for the old world is shown after
+	// reuse. Listeners registered for this context are expected to register again when it is reused.
+	DrawDataCapture.Reset();
+	EndFrame();
+	BeginFrame();
+
+	DrawEvent.Clear();
+	DrawLists.Empty();
+	SlateDrawDataCaches.Empty();
+	DrawDataFrameNumber++;
+
+	bHasActiveItem = false;
+	bWantsMouseCapture = false;
+	MouseCursor = EMouseCursor::None;
+	bIsIdle = false;
+	bIsHibernating = false;
+	bRedrawRequested = true;
+	TimeSinceUpdate = 0.f;
+}
+
+bool FImGuiContextProxy::HasWindowsInFrame() const
+{
+	if (!bIsFrameStarted)
+	{
+		return false;
+	}
+
+	// Fallback window is active in every frame, but it is hidden unless something was drawn in it.
+	for (const ImGuiWindow* Window : Context->Windows)
+	{
+		if (Window->Active && (!Window->IsFallbackWindow || Window->WriteAccessed))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FImGuiContextProxy::Hibernate()
+{
+	bIsHibernating = true;
+
+	FGuardCurrentContext GuardContext;
+	SetAsCurrent();
+
+	// Same as 'Compact memory' in ImGui metrics window: the next NewFrame frees transient buffers of inactive windows
+	// and tables, including their draw lists.
+	Context->GcCompactAll = true;
+	EndFrame();
+	BeginFrame();
+
+	DrawLists.Empty();
+	SlateDrawDataCaches.Empty();
+	DrawDataFrameNumber++;
+
+	Allocator->Trim();
+}
+
+void FImGuiContextProxy::WakeUp()
+{
+	bIsHibernating = false;
+	RestartFrame();
+}
+
+void FImGuiContextProxy::RestartFrame()
+{
+	FGuardCurrentContext GuardContext;
+	SetAsCurrent();
+
+	EndFrame();
+	BeginFrame();
+}
+
+void FImGuiContextProxy::Reuse(const FString& InName, int32 InContextIndex)
+{
+	ContextIndex = InContextIndex;
+
+	if (Name != InName)
+	{
+		Name = InName;
+		IniFilename = TCHAR_TO_ANSI(*GetIniFile(InName));
+
+		FGuardCurrentContext GuardContext;
+		SetAsCurrent();
+
+		// Detach existing windows and tables from the old settings before loading the new ones. Loaded settings apply
+		// to windows and tables created after this point, while existing ones keep their current state.
+		ImGui::GetIO().IniFilename = IniFilename.c_str();
+		ImGui::ClearIniSettings();
+		ImGui::LoadIniSettingsFromDisk(IniFilename.c_str());
+	}
+}
+
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+const TArray<FImGuiSlateDrawList>& FImGuiContextProxy::GetSlateDrawData(const FSlateRenderTransform& Transform, const FSlateRotatedRect& VertexClippingRect)
+#else
+const TArray<FImGuiSlateDrawList>& FImGuiContextProxy::GetSlateDrawData(const FSlateRenderTransform& Transform, const FSlateRect& CullingRect)
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+{
+	bool bSameTransform;
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Vertices embed the clipping rectangle, so they are converted in every call.
+	FSlateDrawDataCache& Cache = FindSlateDrawDataCache(Transform, FSlateRect(), bSameTransform);
+#else
+	FSlateDrawDataCache& Cache = FindSlateDrawDataCache(Transform, CullingRect, bSameTransform);
+	if (Cache.FrameNumber == DrawDataFrameNumber && bSameTransform)
+	{
+		return Cache.DrawLists;
+	}
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	Cache.FrameNumber = DrawDataFrameNumber;
+	TArray<FImGuiSlateDrawList>& SlateDrawLists = Cache.DrawLists;
+
+#if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+	SlateDrawLists.SetNum(DrawLists.Num(), false);
+#else
+	SlateDrawLists.SetNum(DrawLists.Num(), EAllowShrinking::No);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	const bool bParallelConversion = CVars::ParallelDrawListConversion.GetValueOnGameThread() > 0;
+	const int32 ParallelMinVertices = CVars::ParallelDrawListMinVertices.GetValueOnGameThread();
+	TArray<int32, TInlineAllocator<32>> ParallelLists;
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	for (int32 Index = 0; Index < DrawLists.Num(); Index++)
+	{
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		DrawLists[Index].CopyDrawData(SlateDrawLists[Index], Transform, VertexClippingRect);
+#else
+		// Skip lists with the same content as in the previous conversion, which is typical for static windows.
+		if (bSameTransform && SlateDrawLists[Index].Fingerprint == DrawLists[Index].GetFingerprint())
+		{
+			DrawListCacheHits++;
+			continue;
+		}
+
+		DrawListCacheMisses++;
+
+		// Defer large lists, so they can be converted in parallel.
+		if (bParallelConversion && DrawLists[Index].NumVertices() >= ParallelMinVertices)
+		{
+			ParallelLists.Add(Index);
+			continue;
+		}
+
+		DrawLists[Index].CopyDrawData(SlateDrawLists[Index], Transform, CullingRect);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	}
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Lists are independent and write to separate outputs, so they can be converted in any order. We join before
+	// returning, so batches are still submitted in the original order.
+	ParallelFor(ParallelLists.Num(), [&](int32 ParallelIndex)
+	{
+		const int32 Index = ParallelLists[ParallelIndex];
+		DrawLists[Index].CopyDrawData(SlateDrawLists[Index], Transform, CullingRect);
+	}, ParallelLists.Num() < 2);
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	return SlateDrawLists;
+}
+
+FImGuiContextProxy::FSlateDrawDataCache& FImGuiContextProxy::FindSlateDrawDataCache(const FSlateRenderTransform& Transform, const FSlateRect& CullingRect, bool& bOutFound)
+{
+	SlateDrawDataCacheUseCounter++;
+
+	FSlateDrawDataCache* Cache = SlateDrawDataCaches.FindByPredicate([&](const FSlateDrawDataCache& Entry)
+	{
+		return Entry.Transform == Transform && Entry.CullingRect == CullingRect;
+	});
+
+	bOutFound = (Cache != nullptr);
+	if (!Cache)
+	{
+		// Use a new entry until the limit is reached and then, the least recently used one.
+		if (SlateDrawDataCaches.Num() < MaxSlateDrawDataCaches)
+		{
+			Cache = &SlateDrawDataCaches.AddDefaulted_GetRef();
+		}
+		else
+		{
+			Cache = &SlateDrawDataCaches[0];
+			for (FSlateDrawDataCache& Entry : SlateDrawDataCaches)
+			{
+				if (Entry.LastUsed < Cache->LastUsed)
+				{
+					Cache = &Entry;
+				}
+			}
+		}
+
+		Cache->Transform = Transform;
+		Cache->CullingRect = CullingRect;
 	}
+
+	Cache->LastUsed = SlateDrawDataCacheUseCounter;
+	return *Cache;
 }
 
 void FImGuiContextProxy::ResetDisplaySize()
@@ -141,6 +399,7 @@ void FImGuiContextProxy::SetDPIScale(float Scale)
 	if (DPIScale != Scale)
 	{
 		DPIScale = Scale;
+		bRedrawRequested = true;
 
 		ImGuiStyle NewStyle = ImGuiStyle();
 		NewStyle.ScaleAllSizes(Scale);
@@ -151,6 +410,15 @@ void FImGuiContextProxy::SetDPIScale(float Scale)
 	}
 }
 
+void FImGuiContextProxy::SetDefaultFont(ImFont* Font)
+{
+	if (Context->IO.FontDefault != Font)
+	{
+		Context->IO.FontDefault = Font;
+		bRedrawRequested = true;
+	}
+}
+
 void FImGuiContextProxy::DrawEarlyDebug()
 {
 	if (bIsFrameStarted && !bIsDrawEarlyDebugCalled)
@@ -183,42 +451,123 @@ void FImGuiContextProxy::DrawDebug()
 }
 
 void FImGuiContextProxy::Tick(float DeltaSeconds)
+{
+	if (BeginTick(DeltaSeconds))
+	{
+		AdvanceFrame();
+	}
+}
+
+bool FImGuiContextProxy::BeginTick(float DeltaSeconds)
 {
 	// Making sure that we tick only once per frame.
-	if (LastFrameNumber < GFrameNumber)
+	if (LastFrameNumber >= GFrameNumber)
 	{
-		LastFrameNumber = GFrameNumber;
+		return false;
+	}
 
-		SetAsCurrent();
+	LastFrameNumber = GFrameNumber;
 
-		if (bIsFrameStarted)
-		{
-			// Make sure that draw events are called before the end of the frame.
-			DrawDebug();
+	// With reduced update rate or while idle, we skip ticks. Frame stays open, so widgets keep drawing the last
+	// draw data and input events are queued in ImGui IO until the next update.
+	TimeSinceUpdate += DeltaSeconds;
+	if (UpdateIdleState(DeltaSeconds))
+	{
+		IdleUpdates++;
+		return false;
+	}
 
-			// Ending frame will produce render output that we capture and store for later use. This also puts context to
-			// state in which it does not allow to draw controls, so we want to immediately start a new frame.
-			EndFrame();
-		}
+	if (!ShouldUpdate(DeltaSeconds))
+	{
+		SkippedUpdates++;
+		return false;
+	}
 
-		ImGuiIO& IO = ImGui::GetIO();
+	// Advance ImGui by the whole time since the last update, so animations and timers keep the right pace. Time spent
+	// idle or in ticks skipped beyond the update interval is not passed, so the first frame after it doesn't jump.
+	const float MaxFrameDeltaSeconds = DeltaSeconds + (UpdateRate > 0.f ? 1.f / UpdateRate : 0.f);
+	FrameDeltaSeconds = FMath::Min(TimeSinceUpdate, MaxFrameDeltaSeconds);
+	TimeSinceUpdate = 0.f;
 
-		// Update context information (some data need to be collected before starting a new frame while some other data
-		// may need to be collected after).
-		bHasActiveItem = ImGui::IsAnyItemActive();
-		MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+	// Requests are consumed only by frames that actually begin, so they are not lost in skipped ticks. Local requests
+	// are cleared when the frame begins.
+	if (ContextIndex != Utilities::INVALID_CONTEXT_INDEX)
+	{
+		FImGuiDelegatesContainer::Get().ConsumeRedrawRequest(ContextIndex);
+	}
 
-		// Update remaining context information.
-		bWantsMouseCapture = IO.WantCaptureMouse;
+	if (bIsFrameStarted)
+	{
+		// Make sure that draw events are called before the end of the frame.
+		DrawDebug();
+	}
 
-		// Set Config and Backend flags in this IO context, as InputState IO is only for function use
-		ImGuiInterops::SetFlag(IO.ConfigFlags, ImGuiConfigFlags_NavEnableKeyboard, InputState.IsKeyboardNavigationEnabled());
-		ImGuiInterops::SetFlag(IO.ConfigFlags, ImGuiConfigFlags_NavEnableGamepad, InputState.IsGamepadNavigationEnabled());
-		ImGuiInterops::SetFlag(IO.BackendFlags, ImGuiBackendFlags_HasGamepad, InputState.HasGamepad());
+	return true;
+}
 
-		// Begin a new frame and set the context back to a state in which it allows to draw controls.
-		BeginFrame(DeltaSeconds);
+void FImGuiContextProxy::AdvanceFrame()
+{
+	SetAsCurrent();
+
+	// Ending frame will produce render output that we capture and store for later use. This also puts context to
+	// state in which it does not allow to draw controls, so we want to immediately start a new frame.
+	EndFrame();
+
+	ImGuiIO& IO = ImGui::GetIO();
+
+	// Update context information (some data need to be collected before starting a new frame while some other data
+	// may need to be collected after).
+	bHasActiveItem = ImGui::IsAnyItemActive();
+	MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+
+	// Update remaining context information.
+	bWantsMouseCapture = IO.WantCaptureMouse;
+
+	// Hovered items can show tooltips after delay and text inputs have blinking cursor, so they need updates.
+	bCanIdle = !ImGui::IsAnyItemHovered() && !IO.WantTextInput;
+
+	// Set Config and Backend flags in this IO context, as InputState IO is only for function use
+	ImGuiInterops::SetFlag(IO.ConfigFlags, ImGuiConfigFlags_NavEnableKeyboard, InputState.IsKeyboardNavigationEnabled());
+	ImGuiInterops::SetFlag(IO.ConfigFlags, ImGuiConfigFlags_NavEnableGamepad, InputState.IsGamepadNavigationEnabled());
+	ImGuiInterops::SetFlag(IO.BackendFlags, ImGuiBackendFlags_HasGamepad, InputState.HasGamepad());
+
+	// Begin a new frame and set the context back to a state in which it allows to draw controls.
+	BeginFrame(FrameDeltaSeconds);
+}
+
+bool FImGuiContextProxy::UpdateIdleState(float DeltaSeconds)
+{
+	bIsIdle = false;
+
+	// Only content declared as static can be skipped. Otherwise, delegates need to be called in every frame.
+	FImGuiDelegatesContainer& Delegates = FImGuiDelegatesContainer::Get();
+	if (ContextIndex == Utilities::INVALID_CONTEXT_INDEX || !Delegates.HasStaticContent(ContextIndex))
+	{
+		return false;
+	}
+
+	if (bRedrawRequested || Delegates.IsRedrawRequested(ContextIndex) || InputState.HasPendingInput() || bHasActiveItem || !bCanIdle)
+	{
+		TimeSinceWake = 0.f;
+		return false;
+	}
+
+	TimeSinceWake += DeltaSeconds;
+	bIsIdle = (TimeSinceWake > IDLE_DELAY_SECONDS);
+	return bIsIdle;
+}
+
+bool FImGuiContextProxy::ShouldUpdate(float DeltaSeconds) const
+{
+	// Interactions need immediate feedback, so we switch to the full rate while user is working with ImGui. Requested
+	// redraws (e.g. after fonts or display size changed) don't wait for the next interval either.
+	if (UpdateRate <= 0.f || bHasActiveItem || bWantsMouseCapture || bRedrawRequested)
+	{
+		return true;
 	}
+
+	// Update in the tick closest to the target interval, to avoid skipping an extra tick because of rounding errors.
+	return TimeSinceUpdate + DeltaSeconds * 0.5f >= 1.f / UpdateRate;
 }
 
 void FImGuiContextProxy::BeginFrame(float DeltaTime)
@@ -229,12 +578,20 @@ void FImGuiContextProxy::BeginFrame(float DeltaTime)
 		IO.DeltaTime = DeltaTime;
 
 		InputState.ClearUpdateState();
+		InputState.ClearPendingInput();
+
+		// New frame satisfies pending redraw requests.
+		bRedrawRequested = false;
+
+		Allocator->EndFrame();
 
 		IO.DisplaySize = { (float)DisplaySize.X, (float)DisplaySize.Y };
 
 		ImGui::NewFrame();
 
 		bIsFrameStarted = true;
+		FrameStartCounter = GFrameCounter;
+		bUsesReplacedFonts = false;
 		bIsDrawEarlyDebugCalled = false;
 		bIsDrawDebugCalled = false;
 	}
@@ -250,6 +607,7 @@ void FImGuiContextProxy::EndFrame()
 		// Update our draw data, so we can use them later during Slate rendering while ImGui is in the middle of the
 		// next frame.
 		UpdateDrawData(ImGui::GetDrawData());
+		DrawDataFrameCounter = FrameStartCounter;
 
 		bIsFrameStarted = false;
 	}
@@ -257,6 +615,9 @@ void FImGuiContextProxy::EndFrame()
 
 void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 {
+	// Invalidate draw data converted to Slate format.
+	DrawDataFrameNumber++;
+
 	if (DrawData && DrawData->CmdListsCount > 0)
 	{
 #if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
@@ -275,6 +636,36 @@ void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 		// If we are not rendering then this might be a good moment to empty the array.
 		DrawLists.Empty();
 	}
+
+	UpdateDrawDataCapture();
+}
+
+void FImGuiContextProxy::UpdateDrawDataCapture()
+{
+	const bool bCapture = CVars::CaptureDrawData.GetValueOnAnyThread() > 0;
+	if (bCapture && !DrawDataCapture)
+	{
+		DrawDataCapture = MakeUnique<FImGuiDrawDataCapture>(FImGuiDrawDataCapture::MakeCaptureFilename(Name));
+		if (DrawDataCapture->IsValid())
+		{
+			UE_LOG(LogImGuiDrawDataCapture, Log, TEXT("Capturing draw data of context '%s' to '%s'."), *Name, *DrawDataCapture->GetFilename());
+		}
+		else
+		{
+			UE_LOG(LogImGuiDrawDataCapture, Warning, TEXT("Cannot create capture file '%s'."), *DrawDataCapture->GetFilename());
+		}
+	}
+	else if (!bCapture && DrawDataCapture)
+	{
+		UE_LOG(LogImGuiDrawDataCapture, Log, TEXT("Captured %d frames of context '%s' to '%s'."), DrawDataCapture->GetNumFrames(), *Name,
+			*DrawDataCapture->GetFilename());
+		DrawDataCapture.Reset();
+	}
+
+	if (DrawDataCapture)
+	{
+		DrawDataCapture->WriteFrame(DisplaySize, DrawLists);
+	}
 }
 
 void FImGuiContextProxy::BroadcastWorldEarlyDebug()
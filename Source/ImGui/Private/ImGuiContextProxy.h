@@ -7,12 +7,17 @@
 #include "Utilities/WorldContextIndex.h"
 
 #include <GenericPlatform/ICursor.h>
+#include <Templates/UniquePtr.h>
 
 #include <imgui.h>
 
 #include <string>
 
 
+class FImGuiContextAllocator;
+class FImGuiDrawDataCapture;
+
+
 // Represents a single ImGui context. All the context updates should be done through this proxy. During update it
 // broadcasts draw events to allow listeners draw their controls. After update it stores draw data.
 class FImGuiContextProxy
@@ -31,9 +36,48 @@ public:
 	// Get the name of this context.
 	const FString& GetName() const { return Name; }
 
+	// Get the index of the context, to which this proxy is bound.
+	int32 GetContextIndex() const { return ContextIndex; }
+
+	// Prepare this context to be kept in a pool after its world was destroyed. Session state like draw data, input
+	// and internal draw events is cleared, but ImGui state (windows, tables, settings and style) with its allocations
+	// is kept, so the context can be reused without creating a new one.
+	void Release();
+
+	// Bind a released context to a new world context. If name changes, ImGui settings are reloaded from the ini file
+	// of that name, while windows and tables already created in this context are kept.
+	// @param Name - Name of the context
+	// @param ContextIndex - Index of the world context
+	void Reuse(const FString& Name, int32 ContextIndex);
+
 	// Get draw data from the last frame.
 	const TArray<FImGuiDrawList>& GetDrawData() const { return DrawLists; }
 
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Get draw data from the last frame converted to Slate format. Vertices embed clipping rectangle of the widget, so
+	// in this engine version output is not cached and data are converted in every call.
+	// @param Transform - Transform from ImGui to screen space
+	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
+	const TArray<FImGuiSlateDrawList>& GetSlateDrawData(const FSlateRenderTransform& Transform, const FSlateRotatedRect& VertexClippingRect);
+#else
+	// Get draw data from the last frame converted to Slate format. Converted data are cached separately for a few
+	// most recently used pairs of transform and culling rectangle, so widgets showing the same context (like in
+	// split-screen) don't evict each other's output. Cached output is reused until a new frame is produced and then,
+	// lists whose content fingerprint didn't change keep their previous output.
+	// @param Transform - Transform from ImGui to screen space
+	// @param CullingRect - Rectangle in screen space, outside of which draw commands are not visible
+	const TArray<FImGuiSlateDrawList>& GetSlateDrawData(const FSlateRenderTransform& Transform, const FSlateRect& CullingRect);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	// Get the number of draw lists, whose Slate output was reused because their content and transform didn't change.
+	uint32 GetDrawListCacheHits() const { return DrawListCacheHits; }
+
+	// Get the number of draw lists, which needed to be converted to Slate format.
+	uint32 GetDrawListCacheMisses() const { return DrawListCacheMisses; }
+
+	// Get allocator used by this context, which also tracks its memory statistics.
+	const FImGuiContextAllocator& GetAllocator() const { return *Allocator; }
+
 	// Get input state used by this context.
 	FImGuiInputState& GetInputState() { return InputState; }
 	const FImGuiInputState& GetInputState() const { return InputState; }
@@ -48,7 +92,11 @@ public:
 	const FVector2D& GetDisplaySize() const { return DisplaySize; }
 
 	// Set the desired context display size.
-	void SetDisplaySize(const FVector2D& Size) { DisplaySize = Size; }
+	void SetDisplaySize(const FVector2D& Size)
+	{
+		bRedrawRequested |= (DisplaySize != Size);
+		DisplaySize = Size;
+	}
 
 	// Reset the desired context display size to default size.
 	void ResetDisplaySize();
@@ -59,6 +107,65 @@ public:
 	// Set the DPI scale for this context.
 	void SetDPIScale(float Scale);
 
+	// Set the font used by default in this context. If null, the first font in the atlas is used.
+	void SetDefaultFont(ImFont* Font);
+
+	// Get the target number of frames per second for this context or zero, if it is updated in every tick.
+	float GetUpdateRate() const { return UpdateRate; }
+
+	// Set the target number of frames per second for this context. Between updates, the last draw data are kept and
+	// input is queued for the next frame. While ImGui has an active item or wants mouse capture, context is updated in
+	// every tick regardless of this setting.
+	// @param Rate - Target number of frames per second or zero, to update context in every tick
+	void SetUpdateRate(float Rate) { UpdateRate = FMath::Max(Rate, 0.f); }
+
+	// Get the number of ticks, in which context update was skipped because of the reduced update rate.
+	uint32 GetSkippedUpdates() const { return SkippedUpdates; }
+
+	// Whether context is idle: its content is declared as static and nothing changed since the last update, so new
+	// frames are not generated until input is received or redraw is requested.
+	bool IsIdle() const { return bIsIdle; }
+
+	// Get the number of ticks, in which context update was skipped because context was idle.
+	uint32 GetIdleUpdates() const { return IdleUpdates; }
+
+	// Request a new frame, waking up the context if it is idle or hibernating.
+	void RequestRedraw() { bRedrawRequested = true; }
+
+	// Whether a new frame was requested since the last one was started.
+	bool IsRedrawRequested() const { return bRedrawRequested; }
+
+	// Whether the last frame produced any draw lists.
+	bool HasDrawData() const { return DrawLists.Num() > 0; }
+
+	// Get the engine frame counter (GFrameCounter) from the beginning of the frame that produced the current draw
+	// data. Content drawn in that frame can come from any engine frame since then.
+	uint64 GetDrawDataFrameCounter() const { return DrawDataFrameCounter; }
+
+	// Notify that fonts were replaced. Open frame still uses the old fonts, so a new frame is requested.
+	void OnFontsReplaced() { bUsesReplacedFonts = true; bRedrawRequested = true; }
+
+	// Whether the open frame was started before fonts were replaced.
+	bool UsesReplacedFonts() const { return bUsesReplacedFonts; }
+
+	// Whether any window was drawn in the current frame so far.
+	bool HasWindowsInFrame() const;
+
+	// Whether context is hibernating. Hibernating contexts are not ticked by the context manager.
+	bool IsHibernating() const { return bIsHibernating; }
+
+	// Start hibernation. Context produces one empty frame, during which ImGui compacts transient buffers of all the
+	// windows and tables, and then releases draw data. The next frame stays open until the context wakes up.
+	void Hibernate();
+
+	// End hibernation, so the context can be ticked again. Frame left open during hibernation is restarted, so
+	// delegates and direct draws don't use fonts from an atlas that might have been replaced in the meantime.
+	void WakeUp();
+
+	// End the open frame and start a new one. Used for contexts that are not ticked (hibernating or pooled), to bind
+	// them to fonts from a new atlas before the old one is released.
+	void RestartFrame();
+
 	// Whether this context has an active item (read once per frame during context update).
 	bool HasActiveItem() const { return bHasActiveItem; }
 
@@ -81,12 +188,25 @@ public:
 	// Tick to advance context to the next frame. Only one call per frame will be processed.
 	void Tick(float DeltaSeconds);
 
+	// First part of the tick, which needs to be called on the game thread. It decides whether context should advance
+	// in this frame and if so, calls debug events that weren't called yet.
+	// @returns True, if AdvanceFrame should be called to finish the tick
+	bool BeginTick(float DeltaSeconds);
+
+	// Second part of the tick, which ends the current frame, stores draw data and begins a new frame. It doesn't call
+	// any delegates, so it can run on a worker thread while ImGui current context is thread-local.
+	void AdvanceFrame();
+
 private:
 
+	bool ShouldUpdate(float DeltaSeconds) const;
+	bool UpdateIdleState(float DeltaSeconds);
+
 	void BeginFrame(float DeltaTime = 1.f / 60.f);
 	void EndFrame();
 
 	void UpdateDrawData(ImDrawData* DrawData);
+	void UpdateDrawDataCapture();
 
 	void BroadcastWorldEarlyDebug();
 	void BroadcastMultiContextEarlyDebug();
@@ -96,14 +216,35 @@ private:
 
 	ImGuiContext* Context;
 
+	// Owned by this proxy, but released rather than deleted (see FImGuiContextAllocator::Release).
+	FImGuiContextAllocator* Allocator = nullptr;
+
 	FVector2D DisplaySize = FVector2D::ZeroVector;
 	float DPIScale = 1.f;
 
+	// Target update rate and time accumulated since the last update.
+	float UpdateRate = 0.f;
+	float TimeSinceUpdate = 0.f;
+	float FrameDeltaSeconds = 0.f;
+	uint32 SkippedUpdates = 0;
+
+	// Idle state and time since the last event that woke up the context.
+	float TimeSinceWake = 0.f;
+	uint32 IdleUpdates = 0;
+	bool bIsIdle = false;
+	bool bCanIdle = false;
+	bool bRedrawRequested = true;
+
+	bool bIsHibernating = false;
+
 	EMouseCursor::Type MouseCursor = EMouseCursor::None;
 	bool bHasActiveItem = false;
 	bool bWantsMouseCapture = false;
 
 	bool bIsFrameStarted = false;
+	uint64 FrameStartCounter = 0;
+	uint64 DrawDataFrameCounter = 0;
+	bool bUsesReplacedFonts = false;
 	bool bIsDrawEarlyDebugCalled = false;
 	bool bIsDrawDebugCalled = false;
 
@@ -111,6 +252,34 @@ private:
 
 	TArray<FImGuiDrawList> DrawLists;
 
+	// Draw lists converted to Slate format together with frame number and transform used to produce them.
+	struct FSlateDrawDataCache
+	{
+		TArray<FImGuiSlateDrawList> DrawLists;
+		FSlateRenderTransform Transform;
+		FSlateRect CullingRect;
+		uint32 FrameNumber = 0;
+		uint32 LastUsed = 0;
+	};
+
+	// Number of transform and culling rectangle pairs, for which converted draw data are cached.
+	static constexpr int32 MaxSlateDrawDataCaches = 4;
+
+	FSlateDrawDataCache& FindSlateDrawDataCache(const FSlateRenderTransform& Transform, const FSlateRect& CullingRect, bool& bOutFound);
+
+	TArray<FSlateDrawDataCache, TInlineAllocator<MaxSlateDrawDataCaches>> SlateDrawDataCaches;
+	uint32 SlateDrawDataCacheUseCounter = 0;
+
+	// Statistics of reusing draw lists converted to Slate format.
+	uint32 DrawListCacheHits = 0;
+	uint32 DrawListCacheMisses = 0;
+
+	// Incremented every time when draw lists are updated.
+	uint32 DrawDataFrameNumber = 0;
+
+	// Open while draw data capture is enabled (see ImGui.CaptureDrawData).
+	TUniquePtr<FImGuiDrawDataCapture> DrawDataCapture;
+
 	FString Name;
 	int32 ContextIndex = Utilities::INVALID_CONTEXT_INDEX;
 
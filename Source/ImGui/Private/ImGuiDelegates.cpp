@@ -35,3 +35,23 @@ FSimpleMulticastDelegate& FImGuiDelegates::OnMultiContextDebug()
 {
 	return FImGuiDelegatesContainer::Get().OnMultiContextDebug();
 }
+
+void FImGuiDelegates::SetStaticContent(bool bStatic)
+{
+	SetStaticContent(GWorld, bStatic);
+}
+
+void FImGuiDelegates::SetStaticContent(UWorld* World, bool bStatic)
+{
+	FImGuiDelegatesContainer::Get().SetStaticContent(World, bStatic);
+}
+
+void FImGuiDelegates::RequestRedraw()
+{
+	RequestRedraw(GWorld);
+}
+
+void FImGuiDelegates::RequestRedraw(UWorld* World)
+{
+	FImGuiDelegatesContainer::Get().RequestRedraw(World);
+}
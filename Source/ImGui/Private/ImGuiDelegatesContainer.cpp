@@ -79,10 +79,32 @@ int32 FImGuiDelegatesContainer::GetContextIndex(UWorld* World)
 	return Utilities::GetWorldContextIndex(*World);
 }
 
+bool FImGuiDelegatesContainer::HasBoundDelegates() const
+{
+	if (MultiContextEarlyDebugDelegate.IsBound() || MultiContextDebugDelegate.IsBound())
+	{
+		return true;
+	}
+
+	bool bIsBound = false;
+	PerContext.ForEach([&bIsBound](int32, const FContextEntry& Entry)
+	{
+		bIsBound |= Entry.WorldEarlyDebug.IsBound() || Entry.WorldDebug.IsBound();
+	});
+	return bIsBound;
+}
+
+bool FImGuiDelegatesContainer::HasBoundDelegates(int32 ContextIndex) const
+{
+	const FContextEntry* Entry = PerContext.Find(ContextIndex);
+
+	return MultiContextEarlyDebugDelegate.IsBound() || MultiContextDebugDelegate.IsBound()
+		|| (Entry && (Entry->WorldEarlyDebug.IsBound() || Entry->WorldDebug.IsBound()));
+}
+
 void FImGuiDelegatesContainer::Clear()
 {
-	WorldEarlyDebugDelegates.Empty();
-	WorldDebugDelegates.Empty();
+	PerContext.Reset();
 	MultiContextEarlyDebugDelegate.Clear();
 	MultiContextDebugDelegate.Clear();
 }
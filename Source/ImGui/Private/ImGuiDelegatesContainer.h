@@ -2,7 +2,8 @@
 
 #pragma once
 
-#include <Containers/Map.h>
+#include "Utilities/ContextSlotArray.h"
+
 #include <Delegates/Delegate.h>
 
 
@@ -29,7 +30,7 @@ public:
 	FSimpleMulticastDelegate& OnWorldEarlyDebug(UWorld* World) { return OnWorldEarlyDebug(GetContextIndex(World)); }
 
 	// Get delegate to ImGui world early debug event from known context index.
-	FSimpleMulticastDelegate& OnWorldEarlyDebug(int32 ContextIndex) { return WorldEarlyDebugDelegates.FindOrAdd(ContextIndex); }
+	FSimpleMulticastDelegate& OnWorldEarlyDebug(int32 ContextIndex) { return PerContext.FindOrAdd(ContextIndex).WorldEarlyDebug; }
 
 	// Get delegate to ImGui multi-context early debug event.
 	FSimpleMulticastDelegate& OnMultiContextEarlyDebug() { return MultiContextEarlyDebugDelegate; }
@@ -38,19 +39,74 @@ public:
 	FSimpleMulticastDelegate& OnWorldDebug(UWorld* World) { return OnWorldDebug(GetContextIndex(World)); }
 
 	// Get delegate to ImGui world debug event from known context index.
-	FSimpleMulticastDelegate& OnWorldDebug(int32 ContextIndex) { return WorldDebugDelegates.FindOrAdd(ContextIndex); }
+	FSimpleMulticastDelegate& OnWorldDebug(int32 ContextIndex) { return PerContext.FindOrAdd(ContextIndex).WorldDebug; }
 
 	// Get delegate to ImGui multi-context debug event.
 	FSimpleMulticastDelegate& OnMultiContextDebug() { return MultiContextDebugDelegate; }
 
+	// Check whether any debug delegate is bound, in any context.
+	bool HasBoundDelegates() const;
+
+	// Check whether any debug delegate called for context with given index is bound.
+	bool HasBoundDelegates(int32 ContextIndex) const;
+
+	// Check whether content drawn in context with given index was declared as static.
+	bool HasStaticContent(int32 ContextIndex) const
+	{
+		const FContextEntry* Entry = PerContext.Find(ContextIndex);
+		return Entry && Entry->bStaticContent;
+	}
+
+	// Declare whether content drawn in context of known world instance is static.
+	void SetStaticContent(UWorld* World, bool bStatic) { SetStaticContent(GetContextIndex(World), bStatic); }
+
+	// Declare whether content drawn in context with known context index is static.
+	void SetStaticContent(int32 ContextIndex, bool bStatic) { PerContext.FindOrAdd(ContextIndex).bStaticContent = bStatic; }
+
+	// Request a new frame in context of known world instance.
+	void RequestRedraw(UWorld* World) { RequestRedraw(GetContextIndex(World)); }
+
+	// Request a new frame in context with known context index.
+	void RequestRedraw(int32 ContextIndex) { PerContext.FindOrAdd(ContextIndex).bRedrawRequested = true; }
+
+	// Check whether there is a pending redraw request for context with given index.
+	bool IsRedrawRequested(int32 ContextIndex) const
+	{
+		const FContextEntry* Entry = PerContext.Find(ContextIndex);
+		return Entry && Entry->bRedrawRequested;
+	}
+
+	// Check and clear pending redraw request for context with given index.
+	bool ConsumeRedrawRequest(int32 ContextIndex)
+	{
+		FContextEntry* Entry = PerContext.Find(ContextIndex);
+		if (Entry && Entry->bRedrawRequested)
+		{
+			Entry->bRedrawRequested = false;
+			return true;
+		}
+		return false;
+	}
+
+	// Remove delegates and state of context with given index (e.g. after its world is no longer valid).
+	void RemoveContext(int32 ContextIndex) { PerContext.Remove(ContextIndex); }
+
 private:
 
 	int32 GetContextIndex(UWorld* World);
 
 	void Clear();
 
-	TMap<int32, FSimpleMulticastDelegate> WorldEarlyDebugDelegates;
-	TMap<int32, FSimpleMulticastDelegate> WorldDebugDelegates;
+	// Delegates and flags of a single context, kept together so they can be removed in one operation.
+	struct FContextEntry
+	{
+		FSimpleMulticastDelegate WorldEarlyDebug;
+		FSimpleMulticastDelegate WorldDebug;
+		bool bStaticContent = false;
+		bool bRedrawRequested = false;
+	};
+
+	Utilities::TContextSlotArray<FContextEntry> PerContext;
 	FSimpleMulticastDelegate MultiContextEarlyDebugDelegate;
 	FSimpleMulticastDelegate MultiContextDebugDelegate;
 };
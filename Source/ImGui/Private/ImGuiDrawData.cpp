@@ -2,24 +2,28 @@
 
 #include "ImGuiDrawData.h"
 
+#include "ImGuiVertexConversion.h"
+
+#include <Hash/CityHash.h>
+
+
+namespace
+{
+	// Number of vertices in a batch, which can be addressed by Slate indices.
+	constexpr int64 MaxBatchVertices = FMath::Min<int64>(static_cast<int64>(TNumericLimits<SlateIndex>::Max()) + 1, MAX_int32);
+}
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const
-#else
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const int32 StartVertex, const int32 NumVertices, const FTransform2D& Transform,
+	const FSlateRotatedRect& VertexClippingRect) const
 {
 	// Reset and reserve space in destination buffer.
-#if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
-	OutVertexBuffer.SetNumUninitialized(ImGuiVertexBuffer.Size, false);
-#else
-	OutVertexBuffer.SetNumUninitialized(ImGuiVertexBuffer.Size, EAllowShrinking::No);
-#endif // ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+	OutVertexBuffer.SetNumUninitialized(NumVertices, false);
 
 	// Transform and copy vertex data.
-	for (int Idx = 0; Idx < ImGuiVertexBuffer.Size; Idx++)
+	for (int Idx = 0; Idx < NumVertices; Idx++)
 	{
-		const ImDrawVert& ImGuiVertex = ImGuiVertexBuffer[Idx];
+		const ImDrawVert& ImGuiVertex = ImGuiVertexBuffer[StartVertex + Idx];
 		FSlateVertex& SlateVertex = OutVertexBuffer[Idx];
 
 		// Final UV is calculated in shader as XY * ZW, so we need set all components.
@@ -27,45 +31,325 @@ void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const
 		SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
 		SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
 
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 		const FVector2D VertexPosition = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
 		SlateVertex.Position[0] = VertexPosition.X;
 		SlateVertex.Position[1] = VertexPosition.Y;
 		SlateVertex.ClipRect = VertexClippingRect;
-#else
-#if ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
-		SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
-#else
-		SlateVertex.Position = (FVector2f)Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
-#endif // ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
 		// Unpack ImU32 color.
 		SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
 	}
 }
-
-void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const
+#else
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const int32 StartVertex, const int32 NumVertices, const FTransform2D& Transform) const
 {
-	// Reset buffer.
+	// Reset and reserve space in destination buffer.
 #if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
-	OutIndexBuffer.SetNumUninitialized(NumElements, false);
+	OutVertexBuffer.SetNumUninitialized(NumVertices, false);
 #else
-	OutIndexBuffer.SetNumUninitialized(NumElements, EAllowShrinking::No);
+	OutVertexBuffer.SetNumUninitialized(NumVertices, EAllowShrinking::No);
 #endif // ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
 
+	// Transform and copy vertex data.
+	ImGuiVertexConversion::Convert(ImGuiVertexBuffer.Data + StartVertex, OutVertexBuffer.GetData(), NumVertices, Transform);
+}
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+void FImGuiDrawList::AppendIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements, const int32 VertexOffset) const
+{
+	// Reserve space at the end of the buffer.
+	const int32 Offset = OutIndexBuffer.AddUninitialized(NumElements);
+	SlateIndex* Dst = OutIndexBuffer.GetData() + Offset;
+
+	// If both index types have the same size and there is no offset, we can copy indices directly.
+	if (sizeof(ImDrawIdx) == sizeof(SlateIndex) && VertexOffset == 0)
+	{
+		FMemory::Memcpy(Dst, ImGuiIndexBuffer.Data + StartIndex, NumElements * sizeof(SlateIndex));
+		return;
+	}
+
 	// Copy elements (slow copy because of different sizes of ImDrawIdx and SlateIndex and because SlateIndex can
 	// have different size on different platforms).
 	for (int i = 0; i < NumElements; i++)
 	{
-		OutIndexBuffer[i] = ImGuiIndexBuffer[StartIndex + i];
+		Dst[i] = ImGuiIndexBuffer[StartIndex + i] + VertexOffset;
 	}
 }
 
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+void FImGuiDrawList::CopyDrawData(FImGuiSlateDrawList& OutDrawList, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const
+#else
+void FImGuiDrawList::CopyDrawData(FImGuiSlateDrawList& OutDrawList, const FTransform2D& Transform, const FSlateRect& CullingRect) const
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+{
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Culling is done in ImGui space, using bounds of the culling rectangle transformed back to that space. For
+	// rotated transforms those bounds are larger than needed, but they never cull visible commands.
+	const FSlateRect ImGuiCullingRect = TransformRect(Transform.Inverse(), CullingRect);
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+	int32 NumBatches = 0;
+
+	auto CopyBatch = [&](const FBatchRange& Range)
+	{
+		// Reuse existing batches with their buffers, so memory can be reused.
+		if (NumBatches == OutDrawList.Batches.Num())
+		{
+			OutDrawList.Batches.AddDefaulted();
+		}
+		FImGuiSlateDrawBatch& SlateBatch = OutDrawList.Batches[NumBatches++];
+
+		// Convert only the slice of vertices used by this batch.
+		const int32 NumVertices = Range.MaxVertex - Range.MinVertex + 1;
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		CopyVertexData(SlateBatch.VertexBuffer, Range.MinVertex, NumVertices, Transform, VertexClippingRect);
+#else
+		CopyVertexData(SlateBatch.VertexBuffer, Range.MinVertex, NumVertices, Transform);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+		// Merge indices of all commands, rebasing them from command vertex offsets to the start of the vertex slice.
+		SlateBatch.IndexBuffer.Reset();
+		for (int32 CommandNb = Range.FirstCommand; CommandNb <= Range.LastCommand; CommandNb++)
+		{
+			const ImDrawCmd& Command = ImGuiCommandBuffer[CommandNb];
+			const bool bSplit = (Range.SplitIdxOffset != INDEX_NONE);
+			AppendIndexData(SlateBatch.IndexBuffer, bSplit ? Range.SplitIdxOffset : (int32)Command.IdxOffset,
+				bSplit ? Range.SplitElemCount : (int32)Command.ElemCount, (int32)Command.VtxOffset - Range.MinVertex);
+		}
+
+		SlateBatch.ClippingRect = TransformRect(Transform, ImGuiInterops::ToSlateRect(Range.ClipRect));
+		SlateBatch.TextureId = ImGuiInterops::ToTextureIndex(Range.TextureId);
+	};
+
+	FBatchRange Batch;
+	bool bHasBatch = false;
+
+	for (int CommandNb = 0; CommandNb < NumCommands(); CommandNb++)
+	{
+		const ImDrawCmd& Command = ImGuiCommandBuffer[CommandNb];
+
+		// Skip commands without geometry (we don't support user callbacks).
+		if (Command.ElemCount == 0)
+		{
+			continue;
+		}
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		// Skip commands clipped out by the culling rectangle (e.g. windows moved outside of the visible part of
+		// the canvas). If all commands are skipped, vertices are not converted at all. Batches cover continuous ranges
+		// of commands, so the open batch needs to be closed before the skipped command.
+		if (Command.ClipRect.x >= ImGuiCullingRect.Right || Command.ClipRect.z <= ImGuiCullingRect.Left
+			|| Command.ClipRect.y >= ImGuiCullingRect.Bottom || Command.ClipRect.w <= ImGuiCullingRect.Top)
+		{
+			if (bHasBatch)
+			{
+				CopyBatch(Batch);
+				bHasBatch = false;
+			}
+			continue;
+		}
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+		int32 MinVertex, MaxVertex;
+		GetVertexRange(Command.IdxOffset, Command.ElemCount, Command.VtxOffset, MinVertex, MaxVertex);
+
+		// With 32-bit ImGui indices and 16-bit Slate indices, a single command can reference more vertices than
+		// Slate indices can address. Such commands are split into batches of whole triangles.
+		if (MaxVertex - MinVertex + 1 > MaxBatchVertices)
+		{
+			if (bHasBatch)
+			{
+				CopyBatch(Batch);
+				bHasBatch = false;
+			}
+
+			SplitCommand(CommandNb, CopyBatch);
+			continue;
+		}
+
+		if (!bHasBatch || !TryMergeCommand(Batch, Command, MinVertex, MaxVertex))
+		{
+			if (bHasBatch)
+			{
+				CopyBatch(Batch);
+			}
+
+			Batch = { CommandNb, CommandNb, MinVertex, MaxVertex, Command.ClipRect, Command.TextureId, {} };
+			bHasBatch = true;
+		}
+		else
+		{
+			Batch.LastCommand = CommandNb;
+		}
+	}
+
+	if (bHasBatch)
+	{
+		CopyBatch(Batch);
+	}
+
+	OutDrawList.Fingerprint = Fingerprint;
+
+#if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+	OutDrawList.Batches.SetNum(NumBatches, false);
+#else
+	OutDrawList.Batches.SetNum(NumBatches, EAllowShrinking::No);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+}
+
 void FImGuiDrawList::TransferDrawData(ImDrawList& Src)
 {
 	// Move data from source to this list.
 	Src.CmdBuffer.swap(ImGuiCommandBuffer);
 	Src.IdxBuffer.swap(ImGuiIndexBuffer);
 	Src.VtxBuffer.swap(ImGuiVertexBuffer);
+
+	// Hash the whole content. ImGui zeroes draw commands before filling them, so padding doesn't affect the result.
+	Fingerprint = CityHash64(reinterpret_cast<const char*>(ImGuiVertexBuffer.Data), ImGuiVertexBuffer.size_in_bytes());
+	Fingerprint = CityHash64WithSeed(reinterpret_cast<const char*>(ImGuiIndexBuffer.Data), ImGuiIndexBuffer.size_in_bytes(), Fingerprint);
+	Fingerprint = CityHash64WithSeed(reinterpret_cast<const char*>(ImGuiCommandBuffer.Data), ImGuiCommandBuffer.size_in_bytes(), Fingerprint);
+}
+
+void FImGuiDrawList::GetVertexRange(const int32 StartIndex, const int32 NumElements, const int32 VertexOffset, int32& OutMinVertex, int32& OutMaxVertex) const
+{
+	ImDrawIdx MinIndex = ImGuiIndexBuffer[StartIndex];
+	ImDrawIdx MaxIndex = MinIndex;
+
+	for (int32 i = 1; i < NumElements; i++)
+	{
+		const ImDrawIdx Index = ImGuiIndexBuffer[StartIndex + i];
+		MinIndex = FMath::Min(MinIndex, Index);
+		MaxIndex = FMath::Max(MaxIndex, Index);
+	}
+
+	OutMinVertex = VertexOffset + MinIndex;
+	OutMaxVertex = VertexOffset + MaxIndex;
+}
+
+bool FImGuiDrawList::IsInsideClipRect(const int32 MinVertex, const int32 MaxVertex, const ImVec4& ClipRect) const
+{
+	for (int32 Idx = MinVertex; Idx <= MaxVertex; Idx++)
+	{
+		const ImVec2& Position = ImGuiVertexBuffer[Idx].pos;
+		if (Position.x < ClipRect.x || Position.y < ClipRect.y || Position.x > ClipRect.z || Position.y > ClipRect.w)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename TCopyBatch>
+void FImGuiDrawList::SplitCommand(const int32 CommandNb, TCopyBatch&& CopyBatch) const
+{
+	const ImDrawCmd& Command = ImGuiCommandBuffer[CommandNb];
+
+	FBatchRange Part = { CommandNb, CommandNb, 0, 0, Command.ClipRect, Command.TextureId, {} };
+	Part.SplitIdxOffset = Command.IdxOffset;
+	Part.SplitElemCount = 0;
+
+	auto CopyPart = [&](const int32 NextIdxOffset)
+	{
+		if (Part.SplitElemCount > 0)
+		{
+			CopyBatch(Part);
+		}
+		Part.SplitIdxOffset = NextIdxOffset;
+		Part.SplitElemCount = 0;
+	};
+
+	for (int32 Element = 0; Element + 2 < (int32)Command.ElemCount; Element += 3)
+	{
+		const int32 IdxOffset = Command.IdxOffset + Element;
+
+		int32 MinVertex, MaxVertex;
+		GetVertexRange(IdxOffset, 3, Command.VtxOffset, MinVertex, MaxVertex);
+
+		// Triangle that cannot be addressed even on its own is dropped.
+		if (MaxVertex - MinVertex + 1 > MaxBatchVertices)
+		{
+			CopyPart(IdxOffset + 3);
+			continue;
+		}
+
+		if (Part.SplitElemCount > 0)
+		{
+			const int32 PartMinVertex = FMath::Min(Part.MinVertex, MinVertex);
+			const int32 PartMaxVertex = FMath::Max(Part.MaxVertex, MaxVertex);
+			if (PartMaxVertex - PartMinVertex + 1 > MaxBatchVertices)
+			{
+				CopyPart(IdxOffset);
+			}
+			else
+			{
+				MinVertex = PartMinVertex;
+				MaxVertex = PartMaxVertex;
+			}
+		}
+
+		Part.MinVertex = MinVertex;
+		Part.MaxVertex = MaxVertex;
+		Part.SplitElemCount += 3;
+	}
+
+	CopyPart(INDEX_NONE);
+}
+
+bool FImGuiDrawList::TryMergeCommand(FBatchRange& Batch, const ImDrawCmd& Command, const int32 MinVertex, const int32 MaxVertex) const
+{
+	if (Command.TextureId != Batch.TextureId)
+	{
+		return false;
+	}
+
+	// Don't merge commands referencing distant parts of the vertex buffer, as that would require converting vertices
+	// that are not used by the batch.
+	const int32 Gap = FMath::Max(MinVertex - Batch.MaxVertex, Batch.MinVertex - MaxVertex) - 1;
+	if (Gap > MaxVertex - MinVertex + 1)
+	{
+		return false;
+	}
+
+	// Batch vertices must be addressable by Slate indices.
+	const int32 NumMergedVertices = FMath::Max(Batch.MaxVertex, MaxVertex) - FMath::Min(Batch.MinVertex, MinVertex) + 1;
+	if (NumMergedVertices > MaxBatchVertices)
+	{
+		return false;
+	}
+
+	const bool bSameClipRect = Command.ClipRect.x == Batch.ClipRect.x && Command.ClipRect.y == Batch.ClipRect.y
+		&& Command.ClipRect.z == Batch.ClipRect.z && Command.ClipRect.w == Batch.ClipRect.w;
+
+	if (bSameClipRect)
+	{
+		Batch.bInsideClipRect.Reset();
+	}
+	else
+	{
+		// Commands with different clipping rectangles are equivalent if clipping has no effect on either of them,
+		// in which case the batch can be clipped to the union of their rectangles. This is common for tables and
+		// child windows, where every cell or window has its own clipping rectangle.
+		if (!IsInsideClipRect(MinVertex, MaxVertex, Command.ClipRect))
+		{
+			return false;
+		}
+
+		if (!Batch.bInsideClipRect.IsSet())
+		{
+			Batch.bInsideClipRect = IsInsideClipRect(Batch.MinVertex, Batch.MaxVertex, Batch.ClipRect);
+		}
+
+		if (!Batch.bInsideClipRect.GetValue())
+		{
+			return false;
+		}
+
+		Batch.ClipRect = ImVec4{ FMath::Min(Batch.ClipRect.x, Command.ClipRect.x), FMath::Min(Batch.ClipRect.y, Command.ClipRect.y),
+			FMath::Max(Batch.ClipRect.z, Command.ClipRect.z), FMath::Max(Batch.ClipRect.w, Command.ClipRect.w) };
+	}
+
+	Batch.MinVertex = FMath::Min(Batch.MinVertex, MinVertex);
+	Batch.MaxVertex = FMath::Max(Batch.MaxVertex, MaxVertex);
+	return true;
 }
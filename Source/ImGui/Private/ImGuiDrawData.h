@@ -5,6 +5,7 @@
 #include "ImGuiInteroperability.h"
 #include "VersionCompatibility.h"
 
+#include <Misc/Optional.h>
 #include <Rendering/RenderingCommon.h>
 
 #include <imgui.h>
@@ -15,15 +16,47 @@ struct FImGuiDrawCommand
 {
 	uint32 NumElements;
 	uint32 IndexOffset;
+	uint32 VertexOffset;
 	FSlateRect ClippingRect;
 	TextureIndex TextureId;
 };
 
+// Batch of adjacent draw commands converted to Slate format and submitted as a single Slate element. Vertex buffer
+// contains only the slice of vertices referenced by the batch and indices are relative to that slice.
+struct FImGuiSlateDrawBatch
+{
+	TArray<FSlateVertex> VertexBuffer;
+	TArray<SlateIndex> IndexBuffer;
+	FSlateRect ClippingRect;
+	TextureIndex TextureId;
+};
+
+// Draw list converted to Slate format.
+struct FImGuiSlateDrawList
+{
+	TArray<FImGuiSlateDrawBatch> Batches;
+
+	// Fingerprint of the source draw list, which can be used to detect whether this output is still up to date.
+	uint64 Fingerprint = 0;
+};
+
 // Wraps raw ImGui draw list data in utilities that transform them for Slate.
 class FImGuiDrawList
 {
 public:
 
+	// Get the fingerprint of the draw list content, calculated when data are transferred from ImGui. Lists with the same
+	// fingerprint can be assumed to produce the same output.
+	FORCEINLINE uint64 GetFingerprint() const { return Fingerprint; }
+
+	// Get raw ImGui buffers, which can be used by renderers consuming ImGui data without conversion to Slate format.
+	FORCEINLINE const ImVector<ImDrawCmd>& GetImGuiCommandBuffer() const { return ImGuiCommandBuffer; }
+	FORCEINLINE const ImVector<ImDrawIdx>& GetImGuiIndexBuffer() const { return ImGuiIndexBuffer; }
+	FORCEINLINE const ImVector<ImDrawVert>& GetImGuiVertexBuffer() const { return ImGuiVertexBuffer; }
+
+	// Get the number of vertices in this list.
+	FORCEINLINE int NumVertices() const { return ImGuiVertexBuffer.Size; }
+
 	// Get the number of draw commands in this list.
 	FORCEINLINE int NumCommands() const { return ImGuiCommandBuffer.Size; }
 
@@ -34,36 +67,106 @@ public:
 	FImGuiDrawCommand GetCommand(int CommandNb, const FTransform2D& Transform) const
 	{
 		const ImDrawCmd& ImGuiCommand = ImGuiCommandBuffer[CommandNb];
-		return { ImGuiCommand.ElemCount, ImGuiCommand.IdxOffset, TransformRect(Transform, ImGuiInterops::ToSlateRect(ImGuiCommand.ClipRect)),
+		return { ImGuiCommand.ElemCount, ImGuiCommand.IdxOffset, ImGuiCommand.VtxOffset, TransformRect(Transform, ImGuiInterops::ToSlateRect(ImGuiCommand.ClipRect)),
 			ImGuiInterops::ToTextureIndex(ImGuiCommand.TextureId) };
 	}
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
+	// Transform and copy a range of vertex data to target buffer (old data in the target buffer are replaced).
 	// @param OutVertexBuffer - Destination buffer
+	// @param StartVertex - Start copying source data starting from this vertex
+	// @param NumVertices - How many vertices we want to copy
 	// @param Transform - Transform to apply to all vertices
 	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const;
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const int32 StartVertex, const int32 NumVertices, const FTransform2D& Transform,
+		const FSlateRotatedRect& VertexClippingRect) const;
 #else
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
+	// Transform and copy a range of vertex data to target buffer (old data in the target buffer are replaced).
 	// @param OutVertexBuffer - Destination buffer
+	// @param StartVertex - Start copying source data starting from this vertex
+	// @param NumVertices - How many vertices we want to copy
 	// @param Transform - Transform to apply to all vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const;
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const int32 StartVertex, const int32 NumVertices, const FTransform2D& Transform) const;
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-	// Transform and copy index data to target buffer (old data in the target buffer are replaced).
-	// Internal index buffer contains enough data to match the sum of NumElements from all draw commands.
+	// Copy index data to the end of target buffer, offsetting every index by a constant value (existing data in the
+	// target buffer are preserved). Internal index buffer contains enough data to match the sum of NumElements from all
+	// draw commands.
 	// @param OutIndexBuffer - Destination buffer
 	// @param StartIndex - Start copying source data starting from this index
 	// @param NumElements - How many elements we want to copy
-	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const;
+	// @param VertexOffset - Offset added to every copied index, e.g. to make it relative to a slice of vertex buffer
+	void AppendIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements, const int32 VertexOffset) const;
+
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Transform and copy draw data to target Slate draw list (old data are replaced). Adjacent draw commands that use
+	// the same texture and equivalent clipping are merged into batches. See FImGuiSlateDrawBatch.
+	// @param OutDrawList - Destination draw list
+	// @param Transform - Transform to apply to all vertices and clipping rectangles
+	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
+	void CopyDrawData(FImGuiSlateDrawList& OutDrawList, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const;
+#else
+	// Transform and copy draw data to target Slate draw list (old data are replaced). Draw commands that are clipped
+	// out by the culling rectangle are skipped. Remaining adjacent draw commands that use the same texture and
+	// equivalent clipping are merged into batches. See FImGuiSlateDrawBatch.
+	// @param OutDrawList - Destination draw list
+	// @param Transform - Transform to apply to all vertices and clipping rectangles
+	// @param CullingRect - Rectangle in transformed space, outside of which draw commands are not visible
+	void CopyDrawData(FImGuiSlateDrawList& OutDrawList, const FTransform2D& Transform, const FSlateRect& CullingRect) const;
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-	// Transfers data from ImGui source list to this object. Leaves source cleared.
+	// Transfers data from ImGui source list to this object and updates fingerprint. Leaves source cleared.
 	void TransferDrawData(ImDrawList& Src);
 
 private:
 
+	// Range of adjacent draw commands merged into one batch.
+	struct FBatchRange
+	{
+		int32 FirstCommand;
+		int32 LastCommand;
+		int32 MinVertex;
+		int32 MaxVertex;
+		ImVec4 ClipRect;
+		ImTextureID TextureId;
+
+		// Whether all vertices in the batch are inside of its clipping rectangle. Calculated only when needed.
+		TOptional<bool> bInsideClipRect;
+
+		// Range of indices used instead of the whole command, when a single command is split into several batches.
+		int32 SplitIdxOffset = INDEX_NONE;
+		int32 SplitElemCount = 0;
+	};
+
+	// Get the range of vertices referenced by a range of indices.
+	// @param StartIndex - First index in the range
+	// @param NumElements - Number of indices in the range
+	// @param VertexOffset - Offset added to every index (see ImDrawCmd::VtxOffset)
+	// @param OutMinVertex - First referenced vertex
+	// @param OutMaxVertex - Last referenced vertex
+	void GetVertexRange(const int32 StartIndex, const int32 NumElements, const int32 VertexOffset, int32& OutMinVertex, int32& OutMaxVertex) const;
+
+	// Check whether all vertices in the range are inside of the clipping rectangle, in which case clipping has no effect
+	// on them.
+	bool IsInsideClipRect(const int32 MinVertex, const int32 MaxVertex, const ImVec4& ClipRect) const;
+
+	// Try to extend batch with the next draw command.
+	// @param Batch - Batch to extend
+	// @param Command - Draw command that directly follows the last command in the batch
+	// @param MinVertex - First vertex referenced by the command
+	// @param MaxVertex - Last vertex referenced by the command
+	// @returns True, if command was merged into the batch
+	bool TryMergeCommand(FBatchRange& Batch, const ImDrawCmd& Command, const int32 MinVertex, const int32 MaxVertex) const;
+
+	// Split a draw command, which references more vertices than a batch can address, into batches of whole triangles.
+	// @param CommandNb - Index of the draw command
+	// @param CopyBatch - Function called for every batch
+	template<typename TCopyBatch>
+	void SplitCommand(const int32 CommandNb, TCopyBatch&& CopyBatch) const;
+
 	ImVector<ImDrawCmd> ImGuiCommandBuffer;
 	ImVector<ImDrawIdx> ImGuiIndexBuffer;
 	ImVector<ImDrawVert> ImGuiVertexBuffer;
+
+	uint64 Fingerprint = 0;
 };
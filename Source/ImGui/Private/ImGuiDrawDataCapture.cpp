@@ -0,0 +1,244 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiDrawDataCapture.h"
+
+#include "VersionCompatibility.h"
+
+#include <HAL/FileManager.h>
+#include <Misc/DateTime.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/MemoryReader.h>
+
+
+namespace
+{
+	constexpr uint32 CaptureMagic = 0x43474D49; // 'IMGC'
+	constexpr uint32 CaptureVersion = 1;
+
+	// Size of a serialized draw command.
+	constexpr int64 CommandSize = sizeof(float) * 4 + sizeof(uint64) + sizeof(uint32) * 3;
+
+	// Check whether archive has enough data left to read the given number of elements.
+	bool CanRead(FArchive& Ar, int32 Num, int64 ElementSize)
+	{
+		return Num >= 0 && !Ar.IsError() && Num * ElementSize <= Ar.TotalSize() - Ar.Tell();
+	}
+
+	// Check whether all commands reference indices and vertices that are inside of the draw list buffers.
+	bool IsValidDrawList(const ImDrawList& DrawList)
+	{
+		for (const ImDrawCmd& Command : DrawList.CmdBuffer)
+		{
+			if (static_cast<uint64>(Command.IdxOffset) + Command.ElemCount > static_cast<uint64>(DrawList.IdxBuffer.Size))
+			{
+				return false;
+			}
+
+			for (uint32 Index = Command.IdxOffset; Index < Command.IdxOffset + Command.ElemCount; Index++)
+			{
+				if (static_cast<uint64>(Command.VtxOffset) + DrawList.IdxBuffer[Index] >= static_cast<uint64>(DrawList.VtxBuffer.Size))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+FImGuiDrawDataCapture::FImGuiDrawDataCapture(const FString& InFilename)
+	: Filename(InFilename)
+	, Writer(IFileManager::Get().CreateFileWriter(*InFilename))
+{
+	if (Writer.IsValid())
+	{
+		uint32 Magic = CaptureMagic;
+		uint32 Version = CaptureVersion;
+		uint32 VertexSize = sizeof(ImDrawVert);
+		uint32 IndexSize = sizeof(ImDrawIdx);
+		*Writer << Magic << Version << VertexSize << IndexSize;
+	}
+}
+
+FImGuiDrawDataCapture::~FImGuiDrawDataCapture()
+{
+	if (Writer.IsValid())
+	{
+		Writer->Close();
+	}
+}
+
+void FImGuiDrawDataCapture::WriteFrame(const FVector2D& DisplaySize, const TArray<FImGuiDrawList>& DrawLists)
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	FArchive& Ar = *Writer;
+
+	float DisplayWidth = DisplaySize.X;
+	float DisplayHeight = DisplaySize.Y;
+	int32 NumDrawLists = DrawLists.Num();
+	Ar << DisplayWidth << DisplayHeight << NumDrawLists;
+
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		const ImVector<ImDrawCmd>& Commands = DrawList.GetImGuiCommandBuffer();
+		int32 NumCommands = Commands.Size;
+		Ar << NumCommands;
+
+		// Commands are written field by field to skip callback pointers, which are meaningless outside of the session.
+		for (const ImDrawCmd& Command : Commands)
+		{
+			ImVec4 ClipRect = Command.ClipRect;
+			uint64 TextureId = static_cast<uint64>(Command.TextureId);
+			uint32 VtxOffset = Command.VtxOffset;
+			uint32 IdxOffset = Command.IdxOffset;
+			uint32 ElemCount = Command.ElemCount;
+			Ar << ClipRect.x << ClipRect.y << ClipRect.z << ClipRect.w << TextureId << VtxOffset << IdxOffset << ElemCount;
+		}
+
+		const ImVector<ImDrawIdx>& Indices = DrawList.GetImGuiIndexBuffer();
+		int32 NumIndices = Indices.Size;
+		Ar << NumIndices;
+		Ar.Serialize(const_cast<ImDrawIdx*>(Indices.Data), NumIndices * sizeof(ImDrawIdx));
+
+		const ImVector<ImDrawVert>& Vertices = DrawList.GetImGuiVertexBuffer();
+		int32 NumVertices = Vertices.Size;
+		Ar << NumVertices;
+		Ar.Serialize(const_cast<ImDrawVert*>(Vertices.Data), NumVertices * sizeof(ImDrawVert));
+	}
+
+	NumFrames++;
+}
+
+FString FImGuiDrawDataCapture::MakeCaptureFilename(const FString& Name)
+{
+#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
+	const FString SavedDir = FPaths::GameSavedDir();
+#else
+	const FString SavedDir = FPaths::ProjectSavedDir();
+#endif
+
+	return FPaths::Combine(*SavedDir, TEXT("ImGui"), TEXT("Captures"), Name + TEXT("-") + FDateTime::Now().ToString() + TEXT(".imguicapture"));
+}
+
+namespace ImGuiDrawDataReplay
+{
+	bool LoadCapture(const FString& Filename, TArray<FImGuiCapturedFrame>& OutFrames, FString& OutError)
+	{
+		OutFrames.Reset();
+
+		TArray<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *Filename))
+		{
+			OutError = FString::Printf(TEXT("Cannot read file '%s'."), *Filename);
+			return false;
+		}
+
+		FMemoryReader Ar{ FileData };
+
+		uint32 Magic = 0, Version = 0, VertexSize = 0, IndexSize = 0;
+		Ar << Magic << Version << VertexSize << IndexSize;
+		if (Ar.IsError() || Magic != CaptureMagic || Version != CaptureVersion)
+		{
+			OutError = FString::Printf(TEXT("File '%s' is not a supported ImGui capture."), *Filename);
+			return false;
+		}
+
+		if (VertexSize != sizeof(ImDrawVert) || IndexSize != sizeof(ImDrawIdx))
+		{
+			OutError = FString::Printf(TEXT("Capture uses %u-byte vertices and %u-byte indices but this build uses %u and %u."),
+				VertexSize, IndexSize, (uint32)sizeof(ImDrawVert), (uint32)sizeof(ImDrawIdx));
+			return false;
+		}
+
+		bool bCorrupted = false;
+		while (!Ar.AtEnd() && !bCorrupted)
+		{
+			FImGuiCapturedFrame& Frame = OutFrames.AddDefaulted_GetRef();
+
+			float DisplayWidth = 0.f, DisplayHeight = 0.f;
+			int32 NumDrawLists = 0;
+			Ar << DisplayWidth << DisplayHeight << NumDrawLists;
+			Frame.DisplaySize = { DisplayWidth, DisplayHeight };
+
+			if (!CanRead(Ar, NumDrawLists, sizeof(int32) * 3))
+			{
+				bCorrupted = true;
+				break;
+			}
+
+			Frame.DrawLists.SetNum(NumDrawLists);
+			for (FImGuiDrawList& DrawList : Frame.DrawLists)
+			{
+				ImDrawList Src{ nullptr };
+
+				int32 NumCommands = 0;
+				Ar << NumCommands;
+				if (!CanRead(Ar, NumCommands, CommandSize))
+				{
+					bCorrupted = true;
+					break;
+				}
+
+				Src.CmdBuffer.resize(NumCommands);
+				for (ImDrawCmd& Command : Src.CmdBuffer)
+				{
+					Command = ImDrawCmd{};
+
+					uint64 TextureId = 0;
+					Ar << Command.ClipRect.x << Command.ClipRect.y << Command.ClipRect.z << Command.ClipRect.w << TextureId
+						<< Command.VtxOffset << Command.IdxOffset << Command.ElemCount;
+					Command.TextureId = static_cast<ImTextureID>(TextureId);
+				}
+
+				int32 NumIndices = 0;
+				Ar << NumIndices;
+				if (!CanRead(Ar, NumIndices, sizeof(ImDrawIdx)))
+				{
+					bCorrupted = true;
+					break;
+				}
+
+				Src.IdxBuffer.resize(NumIndices);
+				Ar.Serialize(Src.IdxBuffer.Data, NumIndices * sizeof(ImDrawIdx));
+
+				int32 NumVertices = 0;
+				Ar << NumVertices;
+				if (!CanRead(Ar, NumVertices, sizeof(ImDrawVert)))
+				{
+					bCorrupted = true;
+					break;
+				}
+
+				Src.VtxBuffer.resize(NumVertices);
+				Ar.Serialize(Src.VtxBuffer.Data, NumVertices * sizeof(ImDrawVert));
+
+				// Replay doesn't check ranges, so invalid commands would read outside of the buffers.
+				if (Ar.IsError() || !IsValidDrawList(Src))
+				{
+					bCorrupted = true;
+					break;
+				}
+
+				DrawList.TransferDrawData(Src);
+			}
+
+			bCorrupted |= Ar.IsError();
+		}
+
+		if (bCorrupted)
+		{
+			// Keep frames that were fully loaded, so captures truncated by a crash can still be replayed.
+			OutFrames.Pop();
+			OutError = FString::Printf(TEXT("Capture '%s' is truncated or corrupted after frame %d."), *Filename, OutFrames.Num());
+			return OutFrames.Num() > 0;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,74 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiDrawData.h"
+
+#include <Serialization/Archive.h>
+#include <Templates/UniquePtr.h>
+
+
+// Captures draw data produced by ImGui context to a binary file, so they can be replayed without a game session.
+//
+// File format (little-endian, all counts are int32):
+//   Header: uint32 Magic ('IMGC'), uint32 Version, uint32 sizeof(ImDrawVert), uint32 sizeof(ImDrawIdx)
+//   Frame:  float DisplayWidth, float DisplayHeight, NumDrawLists, DrawList[NumDrawLists]
+//   DrawList: NumCommands, Command[NumCommands], NumIndices, ImDrawIdx[NumIndices], NumVertices, ImDrawVert[NumVertices]
+//   Command: float ClipRect[4], uint64 TextureId, uint32 VtxOffset, uint32 IdxOffset, uint32 ElemCount
+//
+// Frames follow the header until the end of file. Texture ids are stored as indices used by the module's texture
+// manager, so they identify textures only within the captured session.
+class FImGuiDrawDataCapture
+{
+public:
+
+	// Open a new capture file. Use IsValid to check whether file was successfully created.
+	// @param Filename - Path to the capture file
+	FImGuiDrawDataCapture(const FString& Filename);
+	~FImGuiDrawDataCapture();
+
+	FImGuiDrawDataCapture(const FImGuiDrawDataCapture&) = delete;
+	FImGuiDrawDataCapture& operator=(const FImGuiDrawDataCapture&) = delete;
+
+	// Get the path to the capture file.
+	const FString& GetFilename() const { return Filename; }
+
+	// Whether capture file is open and ready for writing.
+	bool IsValid() const { return Writer.IsValid(); }
+
+	// Get the number of frames written to the capture file.
+	int32 GetNumFrames() const { return NumFrames; }
+
+	// Write a single frame to the capture file.
+	// @param DisplaySize - Display size of the context
+	// @param DrawLists - Draw lists produced in this frame
+	void WriteFrame(const FVector2D& DisplaySize, const TArray<FImGuiDrawList>& DrawLists);
+
+	// Get a unique path for a new capture file in the module's save directory.
+	// @param Name - Name of the captured context
+	static FString MakeCaptureFilename(const FString& Name);
+
+private:
+
+	FString Filename;
+	TUniquePtr<FArchive> Writer;
+	int32 NumFrames = 0;
+};
+
+// Frame loaded from the capture file.
+struct FImGuiCapturedFrame
+{
+	FVector2D DisplaySize = FVector2D::ZeroVector;
+	TArray<FImGuiDrawList> DrawLists;
+};
+
+// Reads frames from a file produced by FImGuiDrawDataCapture.
+namespace ImGuiDrawDataReplay
+{
+	// Load all frames from the capture file.
+	// @param Filename - Path to the capture file
+	// @param OutFrames - Array to fill with loaded frames (old content is replaced)
+	// @param OutError - Set to error description, if loading failed
+	// @returns True, if file was successfully loaded
+	bool LoadCapture(const FString& Filename, TArray<FImGuiCapturedFrame>& OutFrames, FString& OutError);
+}
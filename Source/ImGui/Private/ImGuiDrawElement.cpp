@@ -0,0 +1,270 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiDrawElement.h"
+
+#if IMGUI_WITH_DRAW_ELEMENT
+
+#include "ImGuiDrawData.h"
+#include "ImGuiInteroperability.h"
+#include "VersionCompatibility.h"
+
+#include <Engine/Texture.h>
+#include <GlobalShader.h>
+#include <Hash/CityHash.h>
+#include <PipelineStateCache.h>
+#include <RenderResource.h>
+#include <RenderUtils.h>
+#include <RenderingThread.h>
+#include <RHIStaticStates.h>
+#include <TextureResource.h>
+
+
+namespace
+{
+	// Vertex declaration matching ImDrawVert layout.
+	class FImGuiVertexDeclaration : public FRenderResource
+	{
+	public:
+
+		FVertexDeclarationRHIRef VertexDeclarationRHI;
+
+		virtual void InitRHI(FRHICommandListBase& RHICmdList) override
+		{
+			constexpr uint16 Stride = sizeof(ImDrawVert);
+
+			FVertexDeclarationElementList Elements;
+			Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, pos), VET_Float2, 0, Stride));
+			Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, uv), VET_Float2, 1, Stride));
+			Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, col), VET_UByte4N, 2, Stride));
+			VertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(Elements);
+		}
+
+		virtual void ReleaseRHI() override
+		{
+			VertexDeclarationRHI.SafeRelease();
+		}
+	};
+
+	TGlobalResource<FImGuiVertexDeclaration> GImGuiVertexDeclaration;
+
+	// Combine transform from ImGui to screen space with transform from screen space to clip space.
+	FMatrix44f GetImGuiToClip(const FSlateRenderTransform& ImGuiToScreen, const FIntPoint& TargetSize)
+	{
+		const FVector2D Origin = ImGuiToScreen.TransformPoint(FVector2D{ 0.f, 0.f });
+		const FVector2D AxisX = ImGuiToScreen.TransformPoint(FVector2D{ 1.f, 0.f }) - Origin;
+		const FVector2D AxisY = ImGuiToScreen.TransformPoint(FVector2D{ 0.f, 1.f }) - Origin;
+
+		const float ScaleX = 2.f / FMath::Max(TargetSize.X, 1);
+		const float ScaleY = -2.f / FMath::Max(TargetSize.Y, 1);
+
+		return FMatrix44f{
+			FPlane4f{ AxisX.X * ScaleX, AxisX.Y * ScaleY, 0.f, 0.f },
+			FPlane4f{ AxisY.X * ScaleX, AxisY.Y * ScaleY, 0.f, 0.f },
+			FPlane4f{ 0.f, 0.f, 1.f, 0.f },
+			FPlane4f{ Origin.X * ScaleX - 1.f, Origin.Y * ScaleY + 1.f, 0.f, 1.f } };
+	}
+
+	// Convert clipping rectangle to scissor rectangle in render target pixels.
+	FIntRect ToScissorRect(const FSlateRect& Rect, const FIntPoint& TargetSize)
+	{
+		return FIntRect{
+			FMath::Clamp(FMath::FloorToInt(Rect.Left), 0, TargetSize.X),
+			FMath::Clamp(FMath::FloorToInt(Rect.Top), 0, TargetSize.Y),
+			FMath::Clamp(FMath::CeilToInt(Rect.Right), 0, TargetSize.X),
+			FMath::Clamp(FMath::CeilToInt(Rect.Bottom), 0, TargetSize.Y) };
+	}
+}
+
+void FImGuiRenderData::CopyDrawData(const TArray<FImGuiDrawList>& DrawLists)
+{
+	int32 NumVertices = 0;
+	int32 NumIndices = 0;
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		NumVertices += DrawList.GetImGuiVertexBuffer().Size;
+		NumIndices += DrawList.GetImGuiIndexBuffer().Size;
+	}
+
+	// Reset and reserve space in destination buffers.
+#if ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+	VertexBuffer.SetNumUninitialized(NumVertices, false);
+	IndexBuffer.SetNumUninitialized(NumIndices, false);
+#else
+	VertexBuffer.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+	IndexBuffer.SetNumUninitialized(NumIndices, EAllowShrinking::No);
+#endif // ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING
+	Commands.Reset();
+	TextureIds.Reset();
+
+	int32 VertexOffset = 0;
+	int32 IndexOffset = 0;
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		const ImVector<ImDrawVert>& ImGuiVertexBuffer = DrawList.GetImGuiVertexBuffer();
+		const ImVector<ImDrawIdx>& ImGuiIndexBuffer = DrawList.GetImGuiIndexBuffer();
+
+		// Vertices and indices are copied without any conversion. Commands are rebased to the start of this list.
+		FMemory::Memcpy(VertexBuffer.GetData() + VertexOffset, ImGuiVertexBuffer.Data, ImGuiVertexBuffer.size_in_bytes());
+		FMemory::Memcpy(IndexBuffer.GetData() + IndexOffset, ImGuiIndexBuffer.Data, ImGuiIndexBuffer.size_in_bytes());
+
+		for (const ImDrawCmd& Command : DrawList.GetImGuiCommandBuffer())
+		{
+			if (Command.ElemCount == 0)
+			{
+				continue;
+			}
+
+			const int32 TextureSlot = TextureIds.AddUnique(ImGuiInterops::ToTextureIndex(Command.TextureId));
+			Commands.Add({ Command.ElemCount, IndexOffset + Command.IdxOffset, VertexOffset + Command.VtxOffset,
+				ImGuiInterops::ToSlateRect(Command.ClipRect), TextureSlot });
+		}
+
+		VertexOffset += ImGuiVertexBuffer.Size;
+		IndexOffset += ImGuiIndexBuffer.Size;
+	}
+}
+
+void FImGuiDrawElement::Update(const TArray<FImGuiDrawList>& DrawLists, const FSlateRenderTransform& Transform, const FSlateRect& ClippingRect,
+	const FTextureManager& TextureManager)
+{
+	// Copy draw lists only if their content changed. Transform is not part of render data, so panning, zooming or
+	// moving the widget doesn't invalidate them.
+	uint64 Fingerprint = DrawLists.Num();
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		Fingerprint = CityHash128to64({ Fingerprint, DrawList.GetFingerprint() });
+	}
+
+	if (!CurrentRenderData.IsValid() || CurrentFingerprint != Fingerprint)
+	{
+		CurrentRenderData = AcquireRenderData();
+		CurrentRenderData->CopyDrawData(DrawLists);
+		CurrentRenderData->Version = NextVersion++;
+		CurrentFingerprint = Fingerprint;
+	}
+
+	FFrameState FrameState;
+	FrameState.RenderData = CurrentRenderData;
+	FrameState.ImGuiToScreen = Transform;
+	FrameState.ClippingRect = ClippingRect;
+
+	// Resources are resolved in every update, because texture manager can only be accessed from the game thread and
+	// textures can be replaced without changing draw lists.
+	for (const TextureIndex TextureId : CurrentRenderData->TextureIds)
+	{
+		const UTexture* Texture = TextureManager.GetTextureObject(TextureId);
+		FrameState.Textures.Add(Texture ? Texture->GetResource() : nullptr);
+		FrameState.AlphaTextures.Add(Texture && TextureManager.IsAlphaTexture(TextureId));
+	}
+
+	// Slate enqueues rendering after painting all windows, so data will be in place before this element is drawn.
+	ENQUEUE_RENDER_COMMAND(ImGuiUpdateDrawElement)([Element = AsShared(), FrameState = MoveTemp(FrameState)](FRHICommandListImmediate&) mutable
+	{
+		Element->RenderThreadState = MoveTemp(FrameState);
+	});
+}
+
+FImGuiDrawElement::FRenderDataPtr FImGuiDrawElement::AcquireRenderData()
+{
+	// Render thread releases data when they are replaced, leaving the pool as the only owner (current data are also
+	// referenced by this element).
+	for (const FRenderDataPtr& RenderData : RenderDataPool)
+	{
+		if (RenderData.GetSharedReferenceCount() == 1)
+		{
+			return RenderData;
+		}
+	}
+
+	return RenderDataPool.Add_GetRef(MakeShared<FImGuiRenderData, ESPMode::ThreadSafe>());
+}
+
+void FImGuiDrawElement::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* RenderTarget)
+{
+	if (!RenderThreadState.RenderData.IsValid() || RenderThreadState.RenderData->Commands.Num() == 0)
+	{
+		return;
+	}
+
+	const FImGuiRenderData& Data = *RenderThreadState.RenderData;
+
+	// Slate passes a pointer to the reference of the render target texture.
+	FRHITexture* RenderTargetTexture = RenderTarget ? static_cast<const FTextureRHIRef*>(RenderTarget)->GetReference() : nullptr;
+	if (!RenderTargetTexture)
+	{
+		return;
+	}
+
+	// Upload vertices and indices in ImGui format, but only if they changed since the last upload.
+	if (UploadedVersion != Data.Version)
+	{
+		const uint32 VertexBufferSize = Data.VertexBuffer.Num() * sizeof(ImDrawVert);
+		FRHIResourceCreateInfo VertexBufferCreateInfo(TEXT("ImGuiVertexBuffer"));
+		VertexBufferRHI = RHICmdList.CreateVertexBuffer(VertexBufferSize, BUF_Static, VertexBufferCreateInfo);
+		FMemory::Memcpy(RHICmdList.LockBuffer(VertexBufferRHI, 0, VertexBufferSize, RLM_WriteOnly), Data.VertexBuffer.GetData(), VertexBufferSize);
+		RHICmdList.UnlockBuffer(VertexBufferRHI);
+
+		const uint32 IndexBufferSize = Data.IndexBuffer.Num() * sizeof(ImDrawIdx);
+		FRHIResourceCreateInfo IndexBufferCreateInfo(TEXT("ImGuiIndexBuffer"));
+		IndexBufferRHI = RHICmdList.CreateIndexBuffer(sizeof(ImDrawIdx), IndexBufferSize, BUF_Static, IndexBufferCreateInfo);
+		FMemory::Memcpy(RHICmdList.LockBuffer(IndexBufferRHI, 0, IndexBufferSize, RLM_WriteOnly), Data.IndexBuffer.GetData(), IndexBufferSize);
+		RHICmdList.UnlockBuffer(IndexBufferRHI);
+
+		UploadedVersion = Data.Version;
+	}
+
+	const FIntPoint TargetSize = RenderTargetTexture->GetSizeXY();
+
+	FRHIRenderPassInfo RenderPassInfo(RenderTargetTexture, ERenderTargetActions::Load_Store);
+	RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("ImGui"));
+	RHICmdList.SetViewport(0.f, 0.f, 0.f, TargetSize.X, TargetSize.Y, 1.f);
+
+	FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+	TShaderMapRef<FImGuiVS> VertexShader(ShaderMap);
+	TShaderMapRef<FImGuiPS> PixelShader(ShaderMap);
+
+	FGraphicsPipelineStateInitializer GraphicsPSOInit;
+	RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+	GraphicsPSOInit.BlendState = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+	GraphicsPSOInit.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+	GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+	GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GImGuiVertexDeclaration.VertexDeclarationRHI;
+	GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+	GraphicsPSOInit.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
+	GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+	SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit, 0);
+
+	FImGuiVS::FParameters VertexParameters;
+	VertexParameters.ImGuiToClip = GetImGuiToClip(RenderThreadState.ImGuiToScreen, TargetSize);
+	SetShaderParameters(RHICmdList, VertexShader, VertexShader.GetVertexShader(), VertexParameters);
+
+	RHICmdList.SetStreamSource(0, VertexBufferRHI, 0);
+
+	for (const FImGuiRenderData::FDrawCommand& Command : Data.Commands)
+	{
+		bool bOverlapping = false;
+		const FSlateRect ClipRect = TransformRect(RenderThreadState.ImGuiToScreen, Command.ClipRect).IntersectionWith(RenderThreadState.ClippingRect, bOverlapping);
+		const FIntRect ScissorRect = ToScissorRect(ClipRect, TargetSize);
+		if (!bOverlapping || ScissorRect.Area() <= 0)
+		{
+			continue;
+		}
+
+		const FTextureResource* Resource = RenderThreadState.Textures[Command.TextureSlot];
+		const bool bHasResource = Resource && Resource->TextureRHI;
+		FImGuiPS::FParameters PixelParameters;
+		PixelParameters.Texture = bHasResource ? Resource->TextureRHI.GetReference() : GWhiteTexture->TextureRHI.GetReference();
+		PixelParameters.TextureSampler = TStaticSamplerState<SF_Bilinear>::GetRHI();
+		PixelParameters.TextureIsAlpha = (bHasResource && RenderThreadState.AlphaTextures[Command.TextureSlot]) ? 1 : 0;
+		SetShaderParameters(RHICmdList, PixelShader, PixelShader.GetPixelShader(), PixelParameters);
+
+		RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y, ScissorRect.Max.X, ScissorRect.Max.Y);
+		RHICmdList.DrawIndexedPrimitive(IndexBufferRHI, Command.VertexOffset, 0, Data.VertexBuffer.Num() - Command.VertexOffset,
+			Command.IndexOffset, Command.NumElements / 3, 1);
+	}
+
+	RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
+	RHICmdList.EndRenderPass();
+}
+
+#endif // IMGUI_WITH_DRAW_ELEMENT
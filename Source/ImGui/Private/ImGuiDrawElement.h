@@ -0,0 +1,111 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "TextureManager.h"
+#include "VersionCompatibility.h"
+
+#include <ImGuiShaders.h>
+
+#include <RHIResources.h>
+#include <Rendering/RenderingCommon.h>
+#include <Templates/SharedPointer.h>
+
+#include <imgui.h>
+
+
+class FImGuiDrawList;
+class FTextureResource;
+
+// Custom draw element requires ImGui shaders and an engine version with verified ICustomSlateElement interface.
+#define IMGUI_WITH_DRAW_ELEMENT (IMGUI_WITH_SHADERS && ENGINE_COMPATIBILITY_WITH_CUSTOM_DRAW_ELEMENT)
+
+#if IMGUI_WITH_DRAW_ELEMENT
+
+// ImGui draw data copied without conversion for rendering with ImGui shaders. Data are kept in ImGui space, so they
+// don't depend on the widget transform and can be reused for as long as the draw lists don't change.
+struct FImGuiRenderData
+{
+	struct FDrawCommand
+	{
+		uint32 NumElements;
+		uint32 IndexOffset;
+		uint32 VertexOffset;
+		FSlateRect ClipRect;
+		int32 TextureSlot;
+	};
+
+	// Copy draw lists into continuous buffers (old data are replaced).
+	// @param DrawLists - Source draw lists
+	void CopyDrawData(const TArray<FImGuiDrawList>& DrawLists);
+
+	TArray<ImDrawVert> VertexBuffer;
+	TArray<ImDrawIdx> IndexBuffer;
+	TArray<FDrawCommand> Commands;
+
+	// Textures used by commands.
+	TArray<TextureIndex> TextureIds;
+
+	// Version assigned by the owner, which allows the render thread to detect new content.
+	uint32 Version = 0;
+};
+
+// Custom Slate element rendering ImGui draw data with ImGui shaders. Unlike the default path, which expands every
+// vertex to FSlateVertex, it passes raw ImGui vertex and index buffers to the render thread. Buffers are only copied
+// and uploaded when draw lists change, while the transform from ImGui to screen space is applied by the shader.
+class FImGuiDrawElement : public ICustomSlateElement, public TSharedFromThis<FImGuiDrawElement, ESPMode::ThreadSafe>
+{
+public:
+
+	// Update draw data and pass them to the render thread. Should be called from the game thread, before the element
+	// is added to the Slate draw elements.
+	// @param DrawLists - Source draw lists
+	// @param Transform - Transform from ImGui to screen space
+	// @param ClippingRect - Clipping rectangle of the widget in screen space
+	// @param TextureManager - Texture manager used to find resources of textures referenced by draw commands
+	void Update(const TArray<FImGuiDrawList>& DrawLists, const FSlateRenderTransform& Transform, const FSlateRect& ClippingRect,
+		const FTextureManager& TextureManager);
+
+	// ICustomSlateElement interface
+	virtual void DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* RenderTarget) override;
+
+private:
+
+	using FRenderDataPtr = TSharedPtr<FImGuiRenderData, ESPMode::ThreadSafe>;
+
+	// State passed to the render thread with every update.
+	struct FFrameState
+	{
+		FRenderDataPtr RenderData;
+
+		// Texture resources matching FImGuiRenderData::TextureIds. Null resources are rendered with a white texture.
+		TArray<FTextureResource*> Textures;
+
+		// Flags matching Textures, set for single-channel textures (see FTextureManager::IsAlphaTexture).
+		TArray<bool> AlphaTextures;
+
+		FSlateRenderTransform ImGuiToScreen;
+		FSlateRect ClippingRect;
+	};
+
+	// Get render data that are not used by the render thread anymore or create new ones.
+	FRenderDataPtr AcquireRenderData();
+
+	// Render data allocated by the game thread. Data are recycled once they are released by the render thread.
+	TArray<FRenderDataPtr> RenderDataPool;
+
+	// Render data with the current content and fingerprint of draw lists used to create them.
+	FRenderDataPtr CurrentRenderData;
+	uint64 CurrentFingerprint = 0;
+	uint32 NextVersion = 1;
+
+	// State used by the render thread.
+	FFrameState RenderThreadState;
+
+	// Buffers uploaded by the render thread and version of render data they contain.
+	FBufferRHIRef VertexBufferRHI;
+	FBufferRHIRef IndexBufferRHI;
+	uint32 UploadedVersion = 0;
+};
+
+#endif // IMGUI_WITH_DRAW_ELEMENT
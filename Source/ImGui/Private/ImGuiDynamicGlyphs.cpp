@@ -0,0 +1,362 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiDynamicGlyphs.h"
+
+#include "ImGuiImplementation.h"
+
+#include <CoreGlobals.h>
+#include <HAL/IConsoleManager.h>
+#include <Math/UnrealMathUtility.h>
+#include <Misc/CString.h>
+#include <Misc/ScopeLock.h>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> DynamicGlyphs(TEXT("ImGui.DynamicGlyphs"), 0,
+		TEXT("Number of pages reserved in the font atlas for glyphs rasterized on demand (see FImGuiModule::RequestGlyphs).\n")
+		TEXT("Each page is a row of glyphs, 512 pixels wide. Changing this value rebuilds the font atlas.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT(">0: number of pages"),
+		ECVF_Default);
+}
+
+namespace
+{
+	constexpr int32 RegionWidth = 512;
+	constexpr int32 MaxPages = 64;
+	constexpr int32 Padding = 1;
+
+	// Characters requested within that many frames before rebuild are requested again for the new atlas.
+	constexpr uint64 RecentFrames = 300;
+
+	int32 GetNumPages()
+	{
+		return FMath::Clamp(CVars::DynamicGlyphs.GetValueOnAnyThread(), 0, MaxPages);
+	}
+
+	// Pages fit the largest glyphs of the largest font (with the same rounding as in stbtt_GetGlyphBitmapBox).
+	int32 GetPageHeight(const ImFontAtlas& Atlas)
+	{
+		float MaxSize = 0.f;
+		for (const ImFontConfig& Source : Atlas.Sources)
+		{
+			MaxSize = FMath::Max(MaxSize, FMath::Abs(Source.SizePixels) * Source.RasterizerDensity);
+		}
+		return FMath::CeilToInt(MaxSize) + 2 + Padding;
+	}
+
+	bool IsRegion(const ImFontAtlasCustomRect& Rect)
+	{
+		return Rect.Width == RegionWidth && Rect.Font == nullptr;
+	}
+
+	template<typename TPredicate>
+	void RemoveGlyphs(ImFont& Font, TPredicate&& ShouldRemove)
+	{
+		int32 NumGlyphs = 0;
+		for (int32 Index = 0; Index < Font.Glyphs.Size; Index++)
+		{
+			if (!ShouldRemove(static_cast<uint32>(Font.Glyphs[Index].Codepoint)))
+			{
+				Font.Glyphs[NumGlyphs++] = Font.Glyphs[Index];
+			}
+		}
+		Font.Glyphs.resize(NumGlyphs);
+	}
+}
+
+bool FImGuiDynamicGlyphs::IsEnabled()
+{
+	return GetNumPages() > 0;
+}
+
+void FImGuiDynamicGlyphs::ReserveRegion(ImFontAtlas& Atlas)
+{
+	const int32 NumPages = GetNumPages();
+	if (NumPages > 0)
+	{
+		// Region is identified by being the first custom rectangle.
+		check(Atlas.CustomRects.Size == 0);
+		Atlas.AddCustomRectRegular(RegionWidth, NumPages * GetPageHeight(Atlas));
+	}
+}
+
+bool FImGuiDynamicGlyphs::MatchesSettings(const ImFontAtlas& Atlas)
+{
+	const bool bHasRegion = Atlas.CustomRects.Size > 0 && IsRegion(Atlas.CustomRects[0]);
+	const int32 NumPages = GetNumPages();
+
+	return NumPages > 0
+		? bHasRegion && Atlas.CustomRects[0].Height == NumPages * GetPageHeight(Atlas)
+		: !bHasRegion;
+}
+
+void FImGuiDynamicGlyphs::Request(const char* Text, const char* TextEnd)
+{
+	if (!Text || !IsEnabled())
+	{
+		return;
+	}
+
+	if (!TextEnd)
+	{
+		TextEnd = Text + FCStringAnsi::Strlen(Text);
+	}
+
+	FScopeLock Lock(&RequestsCriticalSection);
+	while (Text < TextEnd)
+	{
+		unsigned int Codepoint;
+		Text += ImTextCharFromUtf8(&Codepoint, Text, TextEnd);
+
+		// ASCII is always in the atlas.
+		if (Codepoint >= 0x80 && Codepoint <= IM_UNICODE_CODEPOINT_MAX)
+		{
+			PendingCodepoints.Add(Codepoint);
+		}
+	}
+}
+
+void FImGuiDynamicGlyphs::Bind(ImFontAtlas& InAtlas)
+{
+	// Glyph tables belong to the shared atlas, so they shouldn't be charged to the current context.
+	ImGuiImplementation::FScopedThreadLocalContext ThreadLocalContext;
+
+	Atlas = nullptr;
+	Pages.Reset();
+	GlyphPages.Reset();
+	MissingGlyphs.Reset();
+	ModifiedFonts.Reset();
+	NumEvictedPages = 0;
+	bDirty = false;
+
+	if (InAtlas.CustomRects.Size == 0 || !IsRegion(InAtlas.CustomRects[0]) || !InAtlas.CustomRects[0].IsPacked())
+	{
+		return;
+	}
+
+	const ImFontAtlasCustomRect& Region = InAtlas.CustomRects[0];
+	Atlas = &InAtlas;
+	RegionMin = { Region.X, Region.Y };
+	PageHeight = GetPageHeight(InAtlas);
+	Pages.SetNum(Region.Height / PageHeight);
+
+	FScopeLock Lock(&RequestsCriticalSection);
+	for (auto It = RequestFrames.CreateIterator(); It; ++It)
+	{
+		if (It.Value() + RecentFrames >= GFrameCounter)
+		{
+			PendingCodepoints.Add(It.Key());
+		}
+		else
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FImGuiDynamicGlyphs::Update(uint64 InOldestFrameInUse, FIntRect& OutDirtyRect)
+{
+	TArray<uint32> Codepoints;
+	{
+		FScopeLock Lock(&RequestsCriticalSection);
+		Codepoints = PendingCodepoints.Array();
+		PendingCodepoints.Reset();
+	}
+
+	if (!Atlas || Codepoints.Num() == 0)
+	{
+		return false;
+	}
+
+	// Glyph tables belong to the shared atlas, so they shouldn't be charged to the current context.
+	ImGuiImplementation::FScopedThreadLocalContext ThreadLocalContext;
+
+	const uint64 Frame = GFrameCounter;
+
+	// Draw data produced in the previous frame can still be rendered, so its pages are always kept.
+	OldestFrameInUse = FMath::Min(InOldestFrameInUse, Frame - 1);
+
+	for (uint32 Codepoint : Codepoints)
+	{
+		RequestFrames.Add(Codepoint, Frame);
+
+		for (ImFont* Font : Atlas->Fonts)
+		{
+			const FGlyphKey Key{ Font, Codepoint };
+			if (const int32* PageIndex = GlyphPages.Find(Key))
+			{
+				Pages[*PageIndex].LastUsedFrame = Frame;
+			}
+			else if (!MissingGlyphs.Contains(Key) && !Font->FindGlyphNoFallback(static_cast<ImWchar>(Codepoint)))
+			{
+				AddGlyph(*Font, Codepoint, Frame);
+			}
+		}
+	}
+
+	for (ImFont* Font : ModifiedFonts)
+	{
+		// Lookup table build appends a tab glyph, unless it is already the last one, so we need to remove it first.
+		RemoveGlyphs(*Font, [](uint32 Codepoint) { return Codepoint == '\t'; });
+		Font->BuildLookupTable();
+	}
+	ModifiedFonts.Reset();
+
+	if (!bDirty)
+	{
+		return false;
+	}
+
+	OutDirtyRect = DirtyRect;
+	bDirty = false;
+	return true;
+}
+
+bool FImGuiDynamicGlyphs::AddGlyph(ImFont& Font, uint32 Codepoint, uint64 Frame)
+{
+	const FGlyphKey Key{ &Font, Codepoint };
+
+	// Like in the atlas builder, glyph comes from the first merged source that has it.
+	ImGuiImplementation::FGlyphBitmap Glyph;
+	const ImFontConfig* Source = nullptr;
+	for (int32 SourceIndex = 0; SourceIndex < Font.SourcesCount && !Source; SourceIndex++)
+	{
+		if (ImGuiImplementation::RasterizeGlyph(Font.Sources[SourceIndex], Codepoint, Glyph))
+		{
+			Source = &Font.Sources[SourceIndex];
+		}
+	}
+
+	const int32 PaddedWidth = Glyph.Width + Padding;
+	if (!Source || Glyph.Height + Padding > PageHeight || PaddedWidth > RegionWidth)
+	{
+		MissingGlyphs.Add(Key);
+		return false;
+	}
+
+	const int32 PageIndex = FindPage(PaddedWidth);
+	if (PageIndex == INDEX_NONE)
+	{
+		// All pages are in use. Glyph will be added when requested after some of them are no longer used.
+		return false;
+	}
+
+	FPage& Page = Pages[PageIndex];
+	const int32 X = RegionMin.X + Page.CursorX;
+	const int32 Y = RegionMin.Y + PageIndex * PageHeight;
+	Page.CursorX += PaddedWidth;
+	Page.LastUsedFrame = Frame;
+	Page.Glyphs.Add(Key);
+	GlyphPages.Add(Key, PageIndex);
+
+	WritePixels(X, Y, Glyph.Width, Glyph.Height, Glyph.Pixels.GetData());
+
+	const float OffsetX = Source->GlyphOffset.x;
+	const float OffsetY = Source->GlyphOffset.y + IM_ROUND(Font.Ascent);
+	const ImVec2& UvScale = Atlas->TexUvScale;
+	Font.AddGlyph(Source, static_cast<ImWchar>(Codepoint),
+		Glyph.X0 + OffsetX, Glyph.Y0 + OffsetY, Glyph.X1 + OffsetX, Glyph.Y1 + OffsetY,
+		X * UvScale.x, Y * UvScale.y, (X + Glyph.Width) * UvScale.x, (Y + Glyph.Height) * UvScale.y,
+		Glyph.AdvanceX);
+	ModifiedFonts.Add(&Font);
+
+	return true;
+}
+
+int32 FImGuiDynamicGlyphs::FindPage(int32 Width)
+{
+	int32 LeastRecentlyUsed = INDEX_NONE;
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+	{
+		if (Pages[PageIndex].CursorX + Width <= RegionWidth)
+		{
+			return PageIndex;
+		}
+
+		if (LeastRecentlyUsed == INDEX_NONE || Pages[PageIndex].LastUsedFrame < Pages[LeastRecentlyUsed].LastUsedFrame)
+		{
+			LeastRecentlyUsed = PageIndex;
+		}
+	}
+
+	// Pages used since the oldest frame that is still displayed can be referenced by draw data, so they cannot be
+	// evicted.
+	if (LeastRecentlyUsed != INDEX_NONE && Pages[LeastRecentlyUsed].LastUsedFrame < OldestFrameInUse)
+	{
+		EvictPage(LeastRecentlyUsed);
+		return LeastRecentlyUsed;
+	}
+
+	return INDEX_NONE;
+}
+
+void FImGuiDynamicGlyphs::EvictPage(int32 PageIndex)
+{
+	FPage& Page = Pages[PageIndex];
+
+	TMap<ImFont*, TSet<uint32>> EvictedCodepoints;
+	for (const FGlyphKey& Key : Page.Glyphs)
+	{
+		GlyphPages.Remove(Key);
+		EvictedCodepoints.FindOrAdd(Key.Key).Add(Key.Value);
+	}
+
+	for (const TPair<ImFont*, TSet<uint32>>& FontCodepoints : EvictedCodepoints)
+	{
+		RemoveGlyphs(*FontCodepoints.Key, [&](uint32 Codepoint) { return FontCodepoints.Value.Contains(Codepoint); });
+		ModifiedFonts.Add(FontCodepoints.Key);
+	}
+
+	Page.Glyphs.Reset();
+	Page.CursorX = 0;
+	WritePixels(RegionMin.X, RegionMin.Y + PageIndex * PageHeight, RegionWidth, PageHeight, nullptr);
+
+	NumEvictedPages++;
+}
+
+void FImGuiDynamicGlyphs::WritePixels(int32 X, int32 Y, int32 Width, int32 Height, const uint8* Pixels)
+{
+	// Atlas keeps Alpha8 data and RGBA32 data, if they were requested for the texture. Both need to stay in sync, so
+	// the texture can be recreated from either of them.
+	for (int32 Row = 0; Row < Height; Row++)
+	{
+		const int32 Offset = (Y + Row) * Atlas->TexWidth + X;
+		const uint8* RowPixels = Pixels ? Pixels + Row * Width : nullptr;
+
+		if (Atlas->TexPixelsAlpha8)
+		{
+			if (RowPixels)
+			{
+				FMemory::Memcpy(Atlas->TexPixelsAlpha8 + Offset, RowPixels, Width);
+			}
+			else
+			{
+				FMemory::Memzero(Atlas->TexPixelsAlpha8 + Offset, Width);
+			}
+		}
+
+		if (Atlas->TexPixelsRGBA32)
+		{
+			for (int32 Column = 0; Column < Width; Column++)
+			{
+				Atlas->TexPixelsRGBA32[Offset + Column] = IM_COL32(255, 255, 255, RowPixels ? RowPixels[Column] : 0);
+			}
+		}
+	}
+
+	const FIntRect Rect{ X, Y, X + Width, Y + Height };
+	if (bDirty)
+	{
+		DirtyRect.Union(Rect);
+	}
+	else
+	{
+		DirtyRect = Rect;
+		bDirty = true;
+	}
+}
@@ -0,0 +1,100 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Containers/Map.h>
+#include <Containers/Set.h>
+#include <HAL/CriticalSection.h>
+#include <Math/IntRect.h>
+
+
+struct ImFont;
+struct ImFontAtlas;
+
+// Glyphs added to an already built font atlas, for characters outside of the glyph ranges of its fonts. This allows
+// to start with a small atlas and pay only for characters that are actually displayed.
+//
+// Space for dynamic glyphs is reserved in the atlas as a region divided into pages (rows of glyphs). Glyphs are
+// rasterized when they are requested for the first time and packed into pages. When all pages are full, page that was
+// used least recently is evicted. Atlas data are updated in place, so only the modified part of the texture needs to
+// be uploaded.
+//
+// ImGui doesn't report missing glyphs, so characters need to be requested explicitly (see FImGuiModule::RequestGlyphs)
+// in every frame in which they are displayed, which also keeps their pages from being evicted. Contexts that don't
+// produce new frames (idle, with reduced update rate or hibernating) keep displaying old draw data without requests,
+// so pages used since the oldest frame that is still displayed are not evicted either.
+class FImGuiDynamicGlyphs
+{
+public:
+
+	// Check whether dynamic glyphs are enabled with 'ImGui.DynamicGlyphs'.
+	static bool IsEnabled();
+
+	// Reserve region for dynamic glyphs in the atlas, which has fonts added but is not yet built. Should be called
+	// before any other custom rectangles are added.
+	static void ReserveRegion(ImFontAtlas& Atlas);
+
+	// Check whether atlas has a region reserved according to the current settings, or no region if dynamic glyphs are
+	// disabled. If not, atlas needs to be rebuilt for settings to take effect.
+	static bool MatchesSettings(const ImFontAtlas& Atlas);
+
+	// Request glyphs for characters in UTF-8 text. Can be called from any thread.
+	void Request(const char* Text, const char* TextEnd = nullptr);
+
+	// Start adding glyphs to the built atlas. Glyphs added to the previous atlas are forgotten, but characters requested
+	// recently are requested again, so they stay available after the atlas is rebuilt.
+	void Bind(ImFontAtlas& Atlas);
+
+	// Add glyphs requested since the last update and evict pages if needed. Should be called on the game thread, when
+	// atlas is not used by contexts.
+	// @param OldestFrameInUse - Engine frame counter from the beginning of the oldest frame whose draw data are still
+	//     displayed (see FImGuiContextProxy::GetDrawDataFrameCounter). Pages used since then are not evicted.
+	// @param OutDirtyRect - Part of the atlas texture, which was modified
+	// @returns True, if atlas texture was modified
+	bool Update(uint64 OldestFrameInUse, FIntRect& OutDirtyRect);
+
+	// Get the number of dynamic glyphs currently in the atlas.
+	int32 GetNumGlyphs() const { return GlyphPages.Num(); }
+
+	// Get the number of pages evicted since the atlas was bound.
+	int32 GetNumEvictedPages() const { return NumEvictedPages; }
+
+private:
+
+	using FGlyphKey = TPair<ImFont*, uint32>;
+
+	struct FPage
+	{
+		TArray<FGlyphKey> Glyphs;
+		uint64 LastUsedFrame = 0;
+		int32 CursorX = 0;
+	};
+
+	bool AddGlyph(ImFont& Font, uint32 Codepoint, uint64 Frame);
+	int32 FindPage(int32 Width);
+	void EvictPage(int32 PageIndex);
+	void WritePixels(int32 X, int32 Y, int32 Width, int32 Height, const uint8* Pixels);
+
+	ImFontAtlas* Atlas = nullptr;
+
+	TArray<FPage> Pages;
+	TMap<FGlyphKey, int32> GlyphPages;
+	TSet<FGlyphKey> MissingGlyphs;
+	TSet<ImFont*> ModifiedFonts;
+	FIntPoint RegionMin = FIntPoint::ZeroValue;
+	int32 PageHeight = 0;
+	int32 NumEvictedPages = 0;
+
+	// Pages used in or after this frame can be referenced by draw data, so they cannot be evicted.
+	uint64 OldestFrameInUse = 0;
+
+	FIntRect DirtyRect;
+	bool bDirty = false;
+
+	// Frame in which characters were requested for the last time, used to request them again after rebuild.
+	TMap<uint32, uint64> RequestFrames;
+
+	// Requests can come from contexts updated on worker threads.
+	FCriticalSection RequestsCriticalSection;
+	TSet<uint32> PendingCodepoints;
+};
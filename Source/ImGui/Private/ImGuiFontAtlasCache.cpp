@@ -0,0 +1,438 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiFontAtlasCache.h"
+
+#include "VersionCompatibility.h"
+
+#include <Async/MappedFileHandle.h>
+#include <Hash/CityHash.h>
+#include <HAL/FileManager.h>
+#include <HAL/IConsoleManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/DateTime.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/MemoryWriter.h>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiFontAtlasCache, Log, All);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> FontAtlasCache(TEXT("ImGui.FontAtlasCache"), 1,
+		TEXT("Load built font atlases from Saved/ImGui/FontAtlasCache instead of rasterizing fonts, if matching entry ")
+		TEXT("exists, and save new atlases there after they are built.\n")
+		TEXT("0: disabled\n")
+		TEXT("1: enabled (default)"),
+		ECVF_Default);
+}
+
+namespace
+{
+	constexpr uint32 CacheMagic = 0x41464D49; // 'IMFA'
+	constexpr uint32 CacheVersion = 1;
+
+	// Number of entries kept in the cache. Every DPI scale and font setup uses a separate entry.
+	constexpr int32 MaxCacheEntries = 16;
+
+	const TCHAR* const CacheExtension = TEXT(".imguifonts");
+
+	FString GetCacheDir()
+	{
+#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
+		const FString SavedDir = FPaths::GameSavedDir();
+#else
+		const FString SavedDir = FPaths::ProjectSavedDir();
+#endif
+
+		return FPaths::Combine(*SavedDir, TEXT("ImGui"), TEXT("FontAtlasCache"));
+	}
+
+	FString GetCacheFilename(uint64 Key)
+	{
+		return FPaths::Combine(*GetCacheDir(), *FString::Printf(TEXT("%016llx%s"), Key, CacheExtension));
+	}
+
+	void HashBytes(uint64& Hash, const void* Data, SIZE_T Size)
+	{
+		Hash = CityHash64WithSeed(static_cast<const char*>(Data), static_cast<uint32>(Size), Hash);
+	}
+
+	template<typename T>
+	void HashValue(uint64& Hash, const T& Value)
+	{
+		HashBytes(Hash, &Value, sizeof(T));
+	}
+
+	// Sequential reader over a memory block, which is either mapped from the cache file or loaded into memory.
+	struct FCacheReader
+	{
+		const uint8* Data;
+		int64 Size;
+		int64 Offset = 0;
+
+		// Get pointer to the next Num bytes and advance, or null if there is not enough data left.
+		const uint8* Skip(int64 Num)
+		{
+			if (Num < 0 || Num > Size - Offset)
+			{
+				return nullptr;
+			}
+
+			const uint8* Ptr = Data + Offset;
+			Offset += Num;
+			return Ptr;
+		}
+
+		template<typename T>
+		bool Read(T& Value)
+		{
+			const uint8* Ptr = Skip(sizeof(T));
+			if (Ptr)
+			{
+				FMemory::Memcpy(&Value, Ptr, sizeof(T));
+			}
+			return Ptr != nullptr;
+		}
+	};
+
+	struct FCachedFont
+	{
+		float FontSize = 0.f;
+		float Ascent = 0.f;
+		float Descent = 0.f;
+		int32 MetricsTotalSurface = 0;
+		int32 NumGlyphs = 0;
+		const uint8* Glyphs = nullptr;
+	};
+
+	bool LoadFromMemory(ImFontAtlas& Atlas, uint64 Key, const uint8* Data, int64 Size)
+	{
+		FCacheReader Reader{ Data, Size };
+
+		// Validate the whole entry before modifying the atlas, so it can still be built normally after a failure.
+		uint32 Magic = 0, Version = 0;
+		uint64 EntryKey = 0;
+		if (!Reader.Read(Magic) || !Reader.Read(Version) || !Reader.Read(EntryKey)
+			|| Magic != CacheMagic || Version != CacheVersion || EntryKey != Key)
+		{
+			return false;
+		}
+
+		int32 TexWidth = 0, TexHeight = 0;
+		ImVec2 TexUvScale, TexUvWhitePixel;
+		ImVec4 TexUvLines[IM_ARRAYSIZE(Atlas.TexUvLines)];
+		int32 PackIdMouseCursors = -1, PackIdLines = -1;
+		int32 NumCustomRects = 0;
+		if (!Reader.Read(TexWidth) || !Reader.Read(TexHeight) || !Reader.Read(TexUvScale) || !Reader.Read(TexUvWhitePixel)
+			|| !Reader.Read(TexUvLines) || !Reader.Read(PackIdMouseCursors) || !Reader.Read(PackIdLines)
+			|| !Reader.Read(NumCustomRects) || TexWidth <= 0 || TexHeight <= 0)
+		{
+			return false;
+		}
+
+		const uint8* CustomRectPositions = Reader.Skip(NumCustomRects * sizeof(uint16) * 2);
+		if (!CustomRectPositions)
+		{
+			return false;
+		}
+
+		int32 NumFonts = 0;
+		if (!Reader.Read(NumFonts) || NumFonts != Atlas.Fonts.Size)
+		{
+			return false;
+		}
+
+		TArray<FCachedFont> Fonts;
+		Fonts.SetNum(NumFonts);
+		for (FCachedFont& Font : Fonts)
+		{
+			if (!Reader.Read(Font.FontSize) || !Reader.Read(Font.Ascent) || !Reader.Read(Font.Descent)
+				|| !Reader.Read(Font.MetricsTotalSurface) || !Reader.Read(Font.NumGlyphs) || Font.NumGlyphs <= 0)
+			{
+				return false;
+			}
+
+			Font.Glyphs = Reader.Skip(Font.NumGlyphs * sizeof(ImFontGlyph));
+			if (!Font.Glyphs)
+			{
+				return false;
+			}
+		}
+
+		const uint8* Pixels = Reader.Skip(static_cast<int64>(TexWidth) * TexHeight);
+		if (!Pixels)
+		{
+			return false;
+		}
+
+		// Custom rectangles that ImFontAtlasBuildInit is going to register (mouse cursors or white pixels are always
+		// registered, thick lines unless they are disabled). Entry must match them, before atlas is modified.
+		int32 ExpectedNumCustomRects = Atlas.CustomRects.Size;
+		int32 ExpectedPackIdMouseCursors = Atlas.PackIdMouseCursors;
+		int32 ExpectedPackIdLines = Atlas.PackIdLines;
+		if (ExpectedPackIdMouseCursors < 0)
+		{
+			ExpectedPackIdMouseCursors = ExpectedNumCustomRects++;
+		}
+		if (ExpectedPackIdLines < 0 && !(Atlas.Flags & ImFontAtlasFlags_NoBakedLines))
+		{
+			ExpectedPackIdLines = ExpectedNumCustomRects++;
+		}
+
+		if (NumCustomRects != ExpectedNumCustomRects || PackIdMouseCursors != ExpectedPackIdMouseCursors
+			|| PackIdLines != ExpectedPackIdLines)
+		{
+			return false;
+		}
+
+		// Register the same custom rectangles as the builder does. Their positions come from the cache.
+		ImFontAtlasBuildInit(&Atlas);
+		check(Atlas.CustomRects.Size == NumCustomRects);
+
+		for (int32 Index = 0; Index < NumCustomRects; Index++)
+		{
+			FMemory::Memcpy(&Atlas.CustomRects[Index].X, CustomRectPositions + Index * 4, sizeof(uint16));
+			FMemory::Memcpy(&Atlas.CustomRects[Index].Y, CustomRectPositions + Index * 4 + 2, sizeof(uint16));
+		}
+
+		Atlas.ClearTexData();
+		Atlas.TexWidth = TexWidth;
+		Atlas.TexHeight = TexHeight;
+		Atlas.TexUvScale = TexUvScale;
+		Atlas.TexUvWhitePixel = TexUvWhitePixel;
+		FMemory::Memcpy(Atlas.TexUvLines, TexUvLines, sizeof(TexUvLines));
+		Atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(static_cast<size_t>(TexWidth) * TexHeight));
+		FMemory::Memcpy(Atlas.TexPixelsAlpha8, Pixels, static_cast<SIZE_T>(TexWidth) * TexHeight);
+
+		// Same as setting up fonts in the builder, but with glyphs already including custom rectangle glyphs.
+		for (int32 Index = 0; Index < NumFonts; Index++)
+		{
+			const FCachedFont& CachedFont = Fonts[Index];
+			ImFont* Font = Atlas.Fonts[Index];
+
+			Font->ClearOutputData();
+			Font->FontSize = CachedFont.FontSize;
+			Font->ContainerAtlas = &Atlas;
+			Font->Ascent = CachedFont.Ascent;
+			Font->Descent = CachedFont.Descent;
+			Font->MetricsTotalSurface = CachedFont.MetricsTotalSurface;
+			Font->Glyphs.resize(CachedFont.NumGlyphs);
+			FMemory::Memcpy(Font->Glyphs.Data, CachedFont.Glyphs, CachedFont.NumGlyphs * sizeof(ImFontGlyph));
+			Font->BuildLookupTable();
+		}
+
+		Atlas.TexReady = true;
+		return true;
+	}
+
+	void TrimCache(const FString& CacheDir)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+
+		TArray<FString> Filenames;
+		FileManager.FindFiles(Filenames, *FPaths::Combine(*CacheDir, *(FString(TEXT("*")) + CacheExtension)), true, false);
+		if (Filenames.Num() <= MaxCacheEntries)
+		{
+			return;
+		}
+
+		TArray<TPair<FDateTime, FString>> Entries;
+		for (const FString& Filename : Filenames)
+		{
+			const FString Path = FPaths::Combine(*CacheDir, *Filename);
+			Entries.Emplace(FileManager.GetTimeStamp(*Path), Path);
+		}
+
+		Entries.Sort([](const TPair<FDateTime, FString>& Lhs, const TPair<FDateTime, FString>& Rhs) { return Lhs.Key < Rhs.Key; });
+		for (int32 Index = 0; Index < Entries.Num() - MaxCacheEntries; Index++)
+		{
+			FileManager.Delete(*Entries[Index].Value, false, false, true);
+		}
+	}
+}
+
+namespace ImGuiFontAtlasCache
+{
+	bool IsEnabled()
+	{
+		return CVars::FontAtlasCache.GetValueOnAnyThread() > 0;
+	}
+
+	bool GetKey(const ImFontAtlas& Atlas, uint64& OutKey)
+	{
+		// Custom builders are not versioned.
+		if (Atlas.FontBuilderIO || Atlas.Sources.Size == 0)
+		{
+			return false;
+		}
+
+		uint64 Hash = 0;
+		HashValue(Hash, CacheVersion);
+		HashValue(Hash, static_cast<uint32>(IMGUI_VERSION_NUM));
+#ifdef IMGUI_ENABLE_FREETYPE
+		HashValue(Hash, static_cast<uint32>(1));
+#endif
+		HashValue(Hash, static_cast<uint32>(sizeof(ImFontGlyph)));
+		HashValue(Hash, static_cast<uint32>(sizeof(ImWchar)));
+
+		HashValue(Hash, Atlas.Flags);
+		HashValue(Hash, Atlas.TexDesiredWidth);
+		HashValue(Hash, Atlas.TexGlyphPadding);
+		HashValue(Hash, Atlas.FontBuilderFlags);
+		HashValue(Hash, Atlas.Fonts.Size);
+
+		for (const ImFontConfig& Source : Atlas.Sources)
+		{
+			if (!Source.FontData || Source.FontDataSize <= 0)
+			{
+				return false;
+			}
+
+			HashBytes(Hash, Source.FontData, Source.FontDataSize);
+			HashValue(Hash, Source.FontDataSize);
+			HashValue(Hash, Source.FontNo);
+			HashValue(Hash, Source.MergeMode);
+			HashValue(Hash, Source.PixelSnapH);
+			HashValue(Hash, Source.OversampleH);
+			HashValue(Hash, Source.OversampleV);
+			HashValue(Hash, Source.SizePixels);
+			HashValue(Hash, Source.GlyphOffset.x);
+			HashValue(Hash, Source.GlyphOffset.y);
+			HashValue(Hash, Source.GlyphMinAdvanceX);
+			HashValue(Hash, Source.GlyphMaxAdvanceX);
+			HashValue(Hash, Source.GlyphExtraAdvanceX);
+			HashValue(Hash, Source.FontBuilderFlags);
+			HashValue(Hash, Source.RasterizerMultiply);
+			HashValue(Hash, Source.RasterizerDensity);
+			HashValue(Hash, Source.EllipsisChar);
+			HashValue(Hash, Atlas.Fonts.index_from_ptr(Atlas.Fonts.find(Source.DstFont)));
+
+			// Default ranges are used, if font doesn't specify any.
+			const ImWchar* GlyphRanges = Source.GlyphRanges ? Source.GlyphRanges : const_cast<ImFontAtlas&>(Atlas).GetGlyphRangesDefault();
+			int32 NumRangeValues = 0;
+			while (GlyphRanges[NumRangeValues])
+			{
+				NumRangeValues++;
+			}
+			HashBytes(Hash, GlyphRanges, NumRangeValues * sizeof(ImWchar));
+			HashValue(Hash, NumRangeValues);
+		}
+
+		// Custom rectangles are filled after build (like the region reserved for dynamic glyphs), so only their layout
+		// affects the atlas.
+		HashValue(Hash, Atlas.CustomRects.Size);
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			HashValue(Hash, Rect.Width);
+			HashValue(Hash, Rect.Height);
+			HashValue(Hash, static_cast<uint32>(Rect.GlyphID));
+			HashValue(Hash, static_cast<uint32>(Rect.GlyphColored));
+			HashValue(Hash, Rect.GlyphAdvanceX);
+			HashValue(Hash, Rect.GlyphOffset.x);
+			HashValue(Hash, Rect.GlyphOffset.y);
+			HashValue(Hash, Rect.Font ? Atlas.Fonts.index_from_ptr(Atlas.Fonts.find(Rect.Font)) : -1);
+		}
+
+		OutKey = Hash;
+		return true;
+	}
+
+	bool Load(ImFontAtlas& Atlas, uint64 Key)
+	{
+		const FString Filename = GetCacheFilename(Key);
+		if (IFileManager::Get().FileSize(*Filename) <= 0)
+		{
+			return false;
+		}
+
+		bool bLoaded = false;
+
+		// Map the file, so the only copy of the pixels is the one made by the atlas.
+		TUniquePtr<IMappedFileHandle> MappedFile{ FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename) };
+		TUniquePtr<IMappedFileRegion> MappedRegion{ MappedFile ? MappedFile->MapRegion() : nullptr };
+		if (MappedRegion)
+		{
+			bLoaded = LoadFromMemory(Atlas, Key, MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+		}
+		else
+		{
+			// Not every platform supports mapped files.
+			TArray<uint8> FileData;
+			if (FFileHelper::LoadFileToArray(FileData, *Filename))
+			{
+				bLoaded = LoadFromMemory(Atlas, Key, FileData.GetData(), FileData.Num());
+			}
+		}
+
+		if (bLoaded)
+		{
+			// Time stamps are used to keep recently used entries when trimming the cache.
+			IFileManager::Get().SetTimeStamp(*Filename, FDateTime::UtcNow());
+		}
+		else
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Warning, TEXT("Ignoring invalid font atlas cache entry '%s'."), *Filename);
+		}
+
+		return bLoaded;
+	}
+
+	bool Save(const ImFontAtlas& Atlas, uint64 Key)
+	{
+		// Atlas with colored glyphs doesn't have all its data in the alpha channel.
+		if (!Atlas.TexReady || !Atlas.TexPixelsAlpha8 || Atlas.TexPixelsUseColors)
+		{
+			return false;
+		}
+
+		TArray<uint8> Data;
+		FMemoryWriter Ar{ Data };
+
+		uint32 Magic = CacheMagic, Version = CacheVersion;
+		int32 TexWidth = Atlas.TexWidth, TexHeight = Atlas.TexHeight;
+		int32 PackIdMouseCursors = Atlas.PackIdMouseCursors, PackIdLines = Atlas.PackIdLines;
+		int32 NumCustomRects = Atlas.CustomRects.Size;
+		Ar << Magic << Version << Key << TexWidth << TexHeight;
+		Ar.Serialize(const_cast<ImVec2*>(&Atlas.TexUvScale), sizeof(ImVec2));
+		Ar.Serialize(const_cast<ImVec2*>(&Atlas.TexUvWhitePixel), sizeof(ImVec2));
+		Ar.Serialize(const_cast<ImVec4*>(Atlas.TexUvLines), sizeof(Atlas.TexUvLines));
+		Ar << PackIdMouseCursors << PackIdLines << NumCustomRects;
+
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			uint16 X = Rect.X, Y = Rect.Y;
+			Ar.Serialize(&X, sizeof(uint16));
+			Ar.Serialize(&Y, sizeof(uint16));
+		}
+
+		int32 NumFonts = Atlas.Fonts.Size;
+		Ar << NumFonts;
+		for (const ImFont* Font : Atlas.Fonts)
+		{
+			float FontSize = Font->FontSize, Ascent = Font->Ascent, Descent = Font->Descent;
+			int32 MetricsTotalSurface = Font->MetricsTotalSurface, NumGlyphs = Font->Glyphs.Size;
+			Ar << FontSize << Ascent << Descent << MetricsTotalSurface << NumGlyphs;
+			Ar.Serialize(const_cast<ImFontGlyph*>(Font->Glyphs.Data), NumGlyphs * sizeof(ImFontGlyph));
+		}
+
+		Ar.Serialize(Atlas.TexPixelsAlpha8, static_cast<int64>(TexWidth) * TexHeight);
+
+		// Write to a temporary file and move it, so other processes never see partially written entries.
+		const FString CacheDir = GetCacheDir();
+		const FString Filename = GetCacheFilename(Key);
+		const FString TempFilename = FPaths::CreateTempFilename(*CacheDir, TEXT("FontAtlas"), TEXT(".tmp"));
+		if (!FFileHelper::SaveArrayToFile(Data, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+		{
+			IFileManager::Get().Delete(*TempFilename, false, false, true);
+			UE_LOG(LogImGuiFontAtlasCache, Warning, TEXT("Failed to save font atlas cache entry '%s'."), *Filename);
+			return false;
+		}
+
+		TrimCache(CacheDir);
+		return true;
+	}
+}
@@ -0,0 +1,39 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <HAL/Platform.h>
+
+
+struct ImFontAtlas;
+
+// Persistent cache of built font atlases in Saved/ImGui/FontAtlasCache. Entries store packed atlas pixels and font
+// glyph tables and are keyed by a hash of everything that affects rasterization: font data, font configurations with
+// glyph ranges and sizes, atlas build flags and the ImGui version (which also versions the rasterizer). Together with
+// DPI scale baked into font sizes, that allows to skip rasterization on startup and on every DPI change to a scale
+// used before.
+//
+// Functions are thread-safe as long as the atlas is not accessed from other threads.
+namespace ImGuiFontAtlasCache
+{
+	// Check whether the cache is enabled with 'ImGui.FontAtlasCache'.
+	bool IsEnabled();
+
+	// Calculate key for atlas, which has fonts added but is not yet built.
+	// @param Atlas - Font atlas
+	// @param OutKey - Calculated key
+	// @returns True, if key was calculated and false if atlas cannot be cached (e.g. it uses a custom font builder)
+	bool GetKey(const ImFontAtlas& Atlas, uint64& OutKey);
+
+	// Load atlas from the cache. Atlas should have the same fonts added as when the key was calculated and not be built.
+	// @param Atlas - Font atlas to load
+	// @param Key - Key calculated with GetKey
+	// @returns True, if atlas was loaded and is ready to use, false if there was no matching entry
+	bool Load(ImFontAtlas& Atlas, uint64 Key);
+
+	// Save built atlas in the cache. Older entries are removed when the cache grows above a fixed number of entries.
+	// @param Atlas - Built font atlas
+	// @param Key - Key calculated with GetKey before the atlas was built
+	// @returns True, if atlas was saved
+	bool Save(const ImFontAtlas& Atlas, uint64 Key);
+}
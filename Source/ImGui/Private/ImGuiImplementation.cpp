@@ -38,10 +38,41 @@ struct FImGuiContextHandle : public Utilities::TRedirectingHandle<ImGuiContext*>
 static ImGuiContext* ImGuiContextPtr = nullptr;
 static FImGuiContextHandle ImGuiContextPtrHandle(ImGuiContextPtr);
 
-// Get the global ImGui context pointer (GImGui) indirectly to allow redirections in obsolete modules.
-#define GImGui (ImGuiContextPtrHandle.Get())
+static FORCEINLINE ImGuiContext*& GetGlobalContextPtr()
+{
+	return ImGuiContextPtrHandle.Get();
+}
+
+#else
+
+static ImGuiContext* ImGuiContextPtr = nullptr;
+
+static FORCEINLINE ImGuiContext*& GetGlobalContextPtr()
+{
+	return ImGuiContextPtr;
+}
+
 #endif // WITH_EDITOR
 
+// Context pointer used instead of the global one by threads that update contexts in parallel or build font atlases
+// (see ImGuiImplementation::FScopedThreadLocalContext).
+static thread_local ImGuiContext* ThreadContextPtr = nullptr;
+static thread_local bool bUseThreadContextPtr = false;
+
+static FORCEINLINE ImGuiContext*& GetContextPtr()
+{
+	return bUseThreadContextPtr ? ThreadContextPtr : GetGlobalContextPtr();
+}
+
+// Get the global ImGui context pointer (GImGui) indirectly to allow redirections in obsolete modules and thread-local
+// contexts.
+#define GImGui (GetContextPtr())
+
+// ImPlot context is stored in the current ImGui context and created on first use (see ImGuiImplementation::GetPlotContext).
+struct ImPlotContext;
+static ImPlotContext*& GetPlotContextPtr();
+#define GImPlot (GetPlotContextPtr())
+
 #include "imgui.cpp"
 #include "imgui_demo.cpp"
 #include "imgui_draw.cpp"
@@ -56,11 +87,133 @@ static FImGuiContextHandle ImGuiContextPtrHandle(ImGuiContextPtr);
 #include <Windows/HideWindowsPlatformTypes.h>
 #endif // PLATFORM_WINDOWS
 
+#include "ImGuiContextAllocator.h"
 #include "ImGuiInteroperability.h"
 
 
+// Backend platform data are reserved for the integration code, which is this module, so we can use them to bind ImPlot
+// context to ImGui context. That way, ImPlot always follows the current ImGui context, including thread-local ones.
+static FORCEINLINE ImPlotContext*& GetBoundPlotContextPtr(ImGuiContext& Context)
+{
+	return reinterpret_cast<ImPlotContext*&>(Context.IO.BackendPlatformUserData);
+}
+
+static ImPlotContext*& GetPlotContextPtr()
+{
+	ImPlotContext*& PlotContext = GetBoundPlotContextPtr(*GImGui);
+	if (UNLIKELY(!PlotContext))
+	{
+		PlotContext = IM_NEW(ImPlotContext)();
+		ImPlot::Initialize(PlotContext);
+	}
+	return PlotContext;
+}
+
+// Similarly, backend renderer data are used to bind allocator to ImGui context. All ImGui allocations in this module go
+// through these functions, so every block has a header that allows to free it (see FImGuiContextAllocator).
+static void* AllocateWithContextAllocator(size_t Size, void*)
+{
+	ImGuiContext* Context = GImGui;
+	return FImGuiContextAllocator::Allocate(Context ? static_cast<FImGuiContextAllocator*>(Context->IO.BackendRendererUserData) : nullptr, Size);
+}
+
+static void FreeWithContextAllocator(void* Ptr, void*)
+{
+	FImGuiContextAllocator::Free(Ptr);
+}
+
+// Set allocator functions during static initialization, before ImGui can allocate anything.
+static struct FImGuiAllocatorFunctionsInitializer
+{
+	FImGuiAllocatorFunctionsInitializer()
+	{
+		ImGui::SetAllocatorFunctions(&AllocateWithContextAllocator, &FreeWithContextAllocator);
+	}
+} ImGuiAllocatorFunctionsInitializer;
+
 namespace ImGuiImplementation
 {
+	void SetContextAllocator(ImGuiContext* Context, FImGuiContextAllocator* Allocator)
+	{
+		check(Context);
+		Context->IO.BackendRendererUserData = Allocator;
+	}
+
+	ImPlotContext* GetPlotContext(ImGuiContext* Context)
+	{
+		return Context ? GetBoundPlotContextPtr(*Context) : nullptr;
+	}
+
+	void DestroyPlotContext(ImGuiContext* Context)
+	{
+		if (ImPlotContext* PlotContext = GetPlotContext(Context))
+		{
+			GetBoundPlotContextPtr(*Context) = nullptr;
+			IM_DELETE(PlotContext);
+		}
+	}
+
+	bool RasterizeGlyph(const ImFontConfig& Source, unsigned int Codepoint, FGlyphBitmap& OutGlyph)
+	{
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+		const unsigned char* FontData = static_cast<const unsigned char*>(Source.FontData);
+		const int FontOffset = FontData ? stbtt_GetFontOffsetForIndex(FontData, Source.FontNo) : -1;
+
+		stbtt_fontinfo FontInfo;
+		if (FontOffset < 0 || !stbtt_InitFont(&FontInfo, FontData, FontOffset))
+		{
+			return false;
+		}
+
+		const int GlyphIndex = stbtt_FindGlyphIndex(&FontInfo, static_cast<int>(Codepoint));
+		if (GlyphIndex == 0)
+		{
+			return false;
+		}
+
+		// Same scale and metrics as in ImFontAtlasBuildWithStbTruetype.
+		const float Scale = Source.SizePixels > 0.f
+			? stbtt_ScaleForPixelHeight(&FontInfo, Source.SizePixels * Source.RasterizerDensity)
+			: stbtt_ScaleForMappingEmToPixels(&FontInfo, -Source.SizePixels * Source.RasterizerDensity);
+		const float InvDensity = 1.f / Source.RasterizerDensity;
+
+		int Advance, LeftSideBearing;
+		stbtt_GetGlyphHMetrics(&FontInfo, GlyphIndex, &Advance, &LeftSideBearing);
+
+		int X0, Y0, X1, Y1;
+		stbtt_GetGlyphBitmapBox(&FontInfo, GlyphIndex, Scale, Scale, &X0, &Y0, &X1, &Y1);
+
+		OutGlyph.Width = X1 - X0;
+		OutGlyph.Height = Y1 - Y0;
+		OutGlyph.Pixels.Reset();
+		OutGlyph.Pixels.SetNumZeroed(OutGlyph.Width * OutGlyph.Height);
+		if (OutGlyph.Pixels.Num() > 0)
+		{
+			stbtt_MakeGlyphBitmap(&FontInfo, OutGlyph.Pixels.GetData(), OutGlyph.Width, OutGlyph.Height, OutGlyph.Width,
+				Scale, Scale, GlyphIndex);
+
+			if (Source.RasterizerMultiply != 1.f)
+			{
+				unsigned char MultiplyTable[256];
+				ImFontAtlasBuildMultiplyCalcLookupTable(MultiplyTable, Source.RasterizerMultiply);
+				for (uint8& Pixel : OutGlyph.Pixels)
+				{
+					Pixel = MultiplyTable[Pixel];
+				}
+			}
+		}
+
+		OutGlyph.X0 = X0 * InvDensity;
+		OutGlyph.Y0 = Y0 * InvDensity;
+		OutGlyph.X1 = X1 * InvDensity;
+		OutGlyph.Y1 = Y1 * InvDensity;
+		OutGlyph.AdvanceX = Advance * Scale * InvDensity;
+		return true;
+#else
+		return false;
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+	}
+
 #if WITH_EDITOR
 	FImGuiContextHandle& GetContextHandle()
 	{
@@ -72,4 +225,18 @@ namespace ImGuiImplementation
 		ImGuiContextPtrHandle.SetParent(&Parent);
 	}
 #endif // WITH_EDITOR
+
+	FScopedThreadLocalContext::FScopedThreadLocalContext()
+		: PrevContext(ThreadContextPtr)
+		, bPrevUseThreadContext(bUseThreadContextPtr)
+	{
+		ThreadContextPtr = nullptr;
+		bUseThreadContextPtr = true;
+	}
+
+	FScopedThreadLocalContext::~FScopedThreadLocalContext()
+	{
+		ThreadContextPtr = PrevContext;
+		bUseThreadContextPtr = bPrevUseThreadContext;
+	}
 }
@@ -2,11 +2,50 @@
 
 #pragma once
 
+#include <Containers/Array.h>
+
+
+class FImGuiContextAllocator;
 struct FImGuiContextHandle;
+struct ImFontConfig;
+struct ImGuiContext;
+struct ImPlotContext;
 
 // Gives access to selected ImGui implementation features.
 namespace ImGuiImplementation
 {
+	// Bind allocator to the ImGui context, so allocations made while that context is current are served by it. Pass
+	// null to use the global allocator. Allocator needs to be unbound before the context is destroyed.
+	void SetContextAllocator(ImGuiContext* Context, FImGuiContextAllocator* Allocator);
+
+	// Get ImPlot context bound to the ImGui context or null, if it wasn't created yet. ImPlot contexts are created on
+	// the first ImPlot call made while their ImGui context is current, so ImPlot::CreateContext should not be used.
+	ImPlotContext* GetPlotContext(ImGuiContext* Context);
+
+	// Destroy ImPlot context bound to the ImGui context, if it was created.
+	void DestroyPlotContext(ImGuiContext* Context);
+
+	// Single-channel bitmap of a glyph with its metrics in font pixels.
+	struct FGlyphBitmap
+	{
+		TArray<uint8> Pixels;
+		int32 Width = 0;
+		int32 Height = 0;
+		float X0 = 0.f;
+		float Y0 = 0.f;
+		float X1 = 0.f;
+		float Y1 = 0.f;
+		float AdvanceX = 0.f;
+	};
+
+	// Rasterize a glyph from the font source the same way as the atlas builder, but without oversampling. Used to add
+	// glyphs to already built atlases.
+	// @param Source - Font source with font data, which is kept by atlas after build
+	// @param Codepoint - Character to rasterize
+	// @param OutGlyph - Rasterized glyph
+	// @returns True, if font has a glyph for that character
+	bool RasterizeGlyph(const ImFontConfig& Source, unsigned int Codepoint, FGlyphBitmap& OutGlyph);
+
 #if WITH_EDITOR
 	// Get the handle to the ImGui Context pointer.
 	FImGuiContextHandle& GetContextHandle();
@@ -14,4 +53,20 @@ namespace ImGuiImplementation
 	// Set the ImGui Context pointer handle.
 	void SetParentContextHandle(FImGuiContextHandle& Parent);
 #endif // WITH_EDITOR
+
+	// While in scope, ImGui current context is local to the calling thread, so different contexts can be updated on
+	// parallel tasks. Thread-local context starts as null and the previous state is restored at the end of the scope.
+	struct FScopedThreadLocalContext
+	{
+		FScopedThreadLocalContext();
+		~FScopedThreadLocalContext();
+
+		FScopedThreadLocalContext(const FScopedThreadLocalContext&) = delete;
+		FScopedThreadLocalContext& operator=(const FScopedThreadLocalContext&) = delete;
+
+	private:
+
+		ImGuiContext* PrevContext;
+		bool bPrevUseThreadContext;
+	};
 }
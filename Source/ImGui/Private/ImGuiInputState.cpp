@@ -14,6 +14,7 @@ FImGuiInputState::FImGuiInputState()
 
 void FImGuiInputState::AddCharacter(TCHAR Char)
 {
+	bHasPendingInput = true;
 	IOFunctions.AddInputCharacter(ImGuiInterops::CastInputChar(Char));
 }
 
@@ -25,6 +26,7 @@ void FImGuiInputState::SetKeyDown(const FKeyEvent& KeyEvent, bool bIsDown)
 
 void FImGuiInputState::SetKeyDown(const FKey& Key, bool bIsDown)
 {
+	bHasPendingInput = true;
 	const ImGuiKey& ImKey = ImGuiInterops::UnrealToImGuiKey(Key);
 	IOFunctions.AddKeyEvent(ImKey, bIsDown);
 
@@ -54,61 +56,73 @@ void FImGuiInputState::SetKeyDown(const FKey& Key, bool bIsDown)
 
 void FImGuiInputState::SetMouseDown(const FPointerEvent& MouseEvent, bool bIsDown)
 {
+	bHasPendingInput = true;
 	const uint32 MouseIndex = ImGuiInterops::GetMouseIndex(MouseEvent);
 	IOFunctions.AddMouseButtonEvent(MouseIndex, bIsDown);
 }
 
 void FImGuiInputState::SetMouseDown(const FKey& MouseButton, bool bIsDown)
 {
+	bHasPendingInput = true;
 	const uint32 MouseIndex = ImGuiInterops::GetMouseIndex(MouseButton);
 	IOFunctions.AddMouseButtonEvent(MouseIndex, bIsDown);
 }
 
 void FImGuiInputState::AddMouseWheelDelta(float DeltaValue)
 {
+	bHasPendingInput = true;
 	IOFunctions.AddMouseWheelEvent(0, DeltaValue);
 }
 
 void FImGuiInputState::SetMousePosition(const FVector2D& Position)
 {
+	// Position can be set without mouse movement, so only changes are treated as new input.
+	bHasPendingInput |= (MousePosition != Position);
 	IOFunctions.AddMousePosEvent(Position.X, Position.Y);
 	MousePosition = Position;
 }
 
 void FImGuiInputState::SetMousePointer(bool bInHasMousePointer)
 {
+	bHasPendingInput |= (bHasMousePointer != bInHasMousePointer);
 	IOFunctions.MouseDrawCursor = bInHasMousePointer;
 	bHasMousePointer = bInHasMousePointer;
 }
 
 void FImGuiInputState::SetTouchDown(bool bIsDown)
 {
+	bHasPendingInput = true;
 	IOFunctions.AddMouseButtonEvent(0, bIsDown);
 	bTouchDown = bIsDown;
 }
 
 void FImGuiInputState::SetTouchPosition(const FVector2D& Position)
 {
+	bHasPendingInput = true;
 	IOFunctions.AddMousePosEvent(Position.X, Position.Y);
 }
 
 void FImGuiInputState::SetGamepadNavigationAxis(const FAnalogInputEvent& AnalogInputEvent, float Value)
 {
+	bHasPendingInput = true;
 	ImGuiInterops::SetGamepadNavigationAxis(IOFunctions, AnalogInputEvent.GetKey(), Value);
 }
 
 void FImGuiInputState::SetKeyboardNavigationEnabled(bool bEnabled)
 {
+	bHasPendingInput |= (bKeyboardNavigationEnabled != bEnabled);
 	bKeyboardNavigationEnabled = bEnabled;
 }
 
 void FImGuiInputState::SetGamepadNavigationEnabled(bool bEnabled)
 {
+	bHasPendingInput |= (bGamepadNavigationEnabled != bEnabled);
 	bGamepadNavigationEnabled = bEnabled;
 }
 
 void FImGuiInputState::SetGamepad(bool bInHasGamepad)
 {
+	bHasPendingInput |= (bHasGamepad != bInHasGamepad);
 	bHasGamepad = bInHasGamepad;
 }
 
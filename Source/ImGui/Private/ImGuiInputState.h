@@ -129,18 +129,26 @@ public:
 	void ResetKeyboard()
 	{
 		ClearModifierKeys();
+		bHasPendingInput = true;
 	}
 
 	// Reset the mouse input state and mark it as dirty.
 	void ResetMouse()
 	{
 		ClearMouseAnalogue();
+		bHasPendingInput = true;
 	}
 
 	// Clear part of the state that is meant to be updated in every frame like: accumulators, buffers, navigation data
 	// and information about dirty parts of keys or mouse buttons arrays.
 	void ClearUpdateState();
 
+	// Check whether any input event was received since the last call to ClearPendingInput.
+	bool HasPendingInput() const { return bHasPendingInput; }
+
+	// Clear information about received input events. Should be called when events are passed to a new ImGui frame.
+	void ClearPendingInput() { bHasPendingInput = false; }
+
 	ImGuiIO IOFunctions; // Only for functional use!
 
 private:
@@ -165,4 +173,6 @@ private:
 	bool bKeyboardNavigationEnabled = false;
 	bool bGamepadNavigationEnabled = false;
 	bool bHasGamepad = false;
+
+	bool bHasPendingInput = true;
 };
@@ -124,6 +124,19 @@ void FImGuiModule::RebuildFontAtlas()
 	}
 }
 
+void FImGuiModule::RequestGlyphs(const FString& Text)
+{
+	RequestGlyphs(TCHAR_TO_UTF8(*Text));
+}
+
+void FImGuiModule::RequestGlyphs(const char* Text)
+{
+	if (ImGuiModuleManager)
+	{
+		ImGuiModuleManager->GetContextManager().RequestGlyphs(Text);
+	}
+}
+
 void FImGuiModule::StartupModule()
 {
 	// Initialize handles to allow cross-module redirections. Other handles will always look for parents in the active
@@ -2,6 +2,7 @@
 
 #include "ImGuiModuleManager.h"
 
+#include "ImGuiDelegatesContainer.h"
 #include "ImGuiInteroperability.h"
 #include "Utilities/WorldContextIndex.h"
 
@@ -11,6 +12,8 @@
 #include <imgui.h>
 
 
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiModuleManager, Log, All);
+
 // High enough z-order guarantees that ImGui output is rendered on top of the game UI.
 constexpr int32 IMGUI_WIDGET_Z_ORDER = 10000;
 
@@ -22,7 +25,7 @@ FImGuiModuleManager::FImGuiModuleManager()
 	: Commands(Properties)
 	, Settings(Properties, Commands)
 	, ImGuiDemo(Properties)
-	, ContextManager(Settings)
+	, ContextManager(Settings, Properties)
 {
 	// Register in context manager to get information whenever a new context proxy is created.
 	ContextManager.OnContextProxyCreated.AddRaw(this, &FImGuiModuleManager::OnContextProxyCreated);
@@ -40,13 +43,18 @@ FImGuiModuleManager::FImGuiModuleManager()
 	}
 
 	// We need to add widgets to active game viewports as they won't generate on-created events. This is especially
-	// important during hot-reloading.
-	AddWidgetsToActiveViewports();
+	// important during hot-reloading. With lazy initialization, this is delayed until ImGui is used.
+	if (ContextManager.IsActive())
+	{
+		AddWidgetsToActiveViewports();
+	}
+	bWasActive = ContextManager.IsActive();
 }
 
 FImGuiModuleManager::~FImGuiModuleManager()
 {
 	ContextManager.OnFontAtlasBuilt.RemoveAll(this);
+	ContextManager.OnFontAtlasUpdated.RemoveAll(this);
 
 	// We are no longer interested with adding widgets to viewports.
 	if (ViewportCreatedHandle.IsValid())
@@ -94,6 +102,7 @@ void FImGuiModuleManager::LoadTextures()
 
 		// Register for atlas built events, so we can rebuild textures.
 		ContextManager.OnFontAtlasBuilt.AddRaw(this, &FImGuiModuleManager::BuildFontAtlasTexture);
+		ContextManager.OnFontAtlasUpdated.AddRaw(this, &FImGuiModuleManager::UpdateFontAtlasTexture);
 
 		BuildFontAtlasTexture();
 	}
@@ -104,16 +113,41 @@ void FImGuiModuleManager::BuildFontAtlasTexture()
 	// Create a font atlas texture.
 	ImFontAtlas& Fonts = ContextManager.GetFontAtlas();
 
+	// Font atlas contains only coverage, so if it can be rendered, we upload it as a single-channel texture.
+	const bool bAlpha = FImGuiContextManager::UseAlphaFontAtlas();
+
 	unsigned char* Pixels;
 	int Width, Height, Bpp;
-	Fonts.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+	if (bAlpha)
+	{
+		Fonts.GetTexDataAsAlpha8(&Pixels, &Width, &Height, &Bpp);
+	}
+	else
+	{
+		Fonts.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+	}
 
 	const TextureIndex FontsTexureIndex = TextureManager.CreateTexture(FontAtlasTextureName, Width, Height, Bpp, Pixels);
+	bFontAtlasTextureAlpha = bAlpha;
+
+	UE_LOG(LogImGuiModuleManager, Log, TEXT("Created %s font atlas texture %dx%d: %d KB (%d KB saved compared to RGBA32)."),
+		bAlpha ? TEXT("Alpha8") : TEXT("RGBA32"), Width, Height, Width * Height * Bpp / 1024, Width * Height * (4 - Bpp) / 1024);
 
 	// Set the font texture index in the ImGui.
 	Fonts.TexID = ImGuiInterops::ToImTextureID(FontsTexureIndex);
 }
 
+void FImGuiModuleManager::UpdateFontAtlasTexture(const FIntRect& DirtyRect)
+{
+	// Dynamic glyphs modify only a small part of the atlas, so instead of creating a new texture, we upload that part.
+	const ImFontAtlas& Fonts = ContextManager.GetFontAtlas();
+
+	const uint32 Bpp = bFontAtlasTextureAlpha ? 1 : 4;
+	const uint8* Pixels = bFontAtlasTextureAlpha ? Fonts.TexPixelsAlpha8 : reinterpret_cast<const uint8*>(Fonts.TexPixelsRGBA32);
+
+	TextureManager.UpdateTextureRegion(ImGuiInterops::ToTextureIndex(Fonts.TexID), DirtyRect, Bpp, Pixels, Fonts.TexWidth * Bpp);
+}
+
 void FImGuiModuleManager::RegisterTick()
 {
 	// Slate Post-Tick is a good moment to end and advance ImGui frame as it minimises a tearing.
@@ -169,6 +203,14 @@ void FImGuiModuleManager::Tick(float DeltaSeconds)
 {
 	if (IsInGameThread())
 	{
+		UpdateActivation();
+
+		// Recreate font atlas texture, if its format was changed.
+		if (bTexturesLoaded && bFontAtlasTextureAlpha != FImGuiContextManager::UseAlphaFontAtlas() && ContextManager.GetFontAtlas().IsBuilt())
+		{
+			BuildFontAtlasTexture();
+		}
+
 		// Update context manager to advance all ImGui contexts to the next frame.
 		ContextManager.Tick(DeltaSeconds);
 
@@ -177,12 +219,34 @@ void FImGuiModuleManager::Tick(float DeltaSeconds)
 	}
 }
 
+void FImGuiModuleManager::UpdateActivation()
+{
+	// With lazy initialization, nothing is created until ImGui is used for the first time. Registered delegates are
+	// checked in every tick, since they are added directly to delegates returned from FImGuiDelegates.
+	if (!ContextManager.IsActive() && (GetProperties().IsInputEnabled() || GetProperties().ShowDemo()
+		|| FImGuiDelegatesContainer::Get().HasBoundDelegates()))
+	{
+		ContextManager.Activate();
+	}
+
+	// Add widgets to viewports that were created while context manager was inactive.
+	const bool bIsActive = ContextManager.IsActive();
+	if (bIsActive && !bWasActive)
+	{
+		AddWidgetsToActiveViewports();
+	}
+	bWasActive = bIsActive;
+}
+
 void FImGuiModuleManager::OnViewportCreated()
 {
 	checkf(FSlateApplication::IsInitialized(), TEXT("We expect Slate to be initialized when game viewport is created."));
 
-	// Create widget to viewport responsible for this event.
-	AddWidgetToViewport(GEngine->GameViewport);
+	// Create widget to viewport responsible for this event (if inactive, widget will be added after activation).
+	if (ContextManager.IsActive())
+	{
+		AddWidgetToViewport(GEngine->GameViewport);
+	}
 }
 
 void FImGuiModuleManager::AddWidgetToViewport(UGameViewportClient* GameViewport)
@@ -190,6 +254,18 @@ void FImGuiModuleManager::AddWidgetToViewport(UGameViewportClient* GameViewport)
 	checkf(GameViewport, TEXT("Null game viewport."));
 	checkf(FSlateApplication::IsInitialized(), TEXT("Slate should be initialized before we can add widget to game viewports."));
 
+	// Skip viewports that already have a widget, which is possible when activation follows viewport creation.
+	const bool bHasWidget = Widgets.ContainsByPredicate([GameViewport](const TWeakPtr<SImGuiLayout>& Widget)
+	{
+		const TSharedPtr<SImGuiLayout> SharedWidget = Widget.Pin();
+		return SharedWidget.IsValid() && SharedWidget->GetGameViewport().Get() == GameViewport;
+	});
+
+	if (bHasWidget)
+	{
+		return;
+	}
+
 	// Make sure that we have a context for this viewport's world and get its index.
 	int32 ContextIndex;
 	auto& ContextProxy = ContextManager.GetWorldContextProxy(*GameViewport->GetWorld(), ContextIndex);
@@ -31,6 +31,9 @@ public:
 	// Get texture resources manager.
 	FTextureManager& GetTextureManager() { return TextureManager; }
 
+	// Check whether the current font atlas texture is a single-channel texture, which requires ImGui shaders.
+	bool IsFontAtlasTextureAlpha() const { return bFontAtlasTextureAlpha; }
+
 	// Event called right after ImGui is updated, to give other subsystems chance to react.
 	FSimpleMulticastDelegate& OnPostImGuiUpdate() { return PostImGuiUpdateEvent; }
 
@@ -49,6 +52,7 @@ private:
 
 	void LoadTextures();
 	void BuildFontAtlasTexture();
+	void UpdateFontAtlasTexture(const FIntRect& DirtyRect);
 
 	bool IsTickRegistered() { return TickDelegateHandle.IsValid(); }
 	void RegisterTick();
@@ -59,6 +63,8 @@ private:
 
 	void Tick(float DeltaSeconds);
 
+	void UpdateActivation();
+
 	void OnViewportCreated();
 
 	void AddWidgetToViewport(UGameViewportClient* GameViewport);
@@ -95,4 +101,6 @@ private:
 	FDelegateHandle ViewportCreatedHandle;
 
 	bool bTexturesLoaded = false;
+	bool bFontAtlasTextureAlpha = false;
+	bool bWasActive = false;
 };
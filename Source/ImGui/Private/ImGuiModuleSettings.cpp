@@ -126,6 +126,8 @@ void FImGuiModuleSettings::UpdateSettings()
 		SetInputProcessorPriority(SettingsObject->InputProcessorPriority);
 		SetToggleInputKey(SettingsObject->ToggleInput);
 		SetCanvasSizeInfo(SettingsObject->CanvasSize);
+		SetUpdateRate(SettingsObject->UpdateRate);
+		SetLazyInitialization(SettingsObject->bLazyInitialization);
 	}
 }
 
@@ -211,6 +213,16 @@ void FImGuiModuleSettings::SetDPIScaleInfo(const FImGuiDPIScaleInfo& ScaleInfo)
 	OnDPIScaleChangedDelegate.Broadcast(DPIScale);
 }
 
+void FImGuiModuleSettings::SetUpdateRate(float Rate)
+{
+	UpdateRate = FMath::Max(Rate, 0.f);
+}
+
+void FImGuiModuleSettings::SetLazyInitialization(bool bLazy)
+{
+	bLazyInitialization = bLazy;
+}
+
 #if WITH_EDITOR
 
 void FImGuiModuleSettings::OnPropertyChanged(class UObject* ObjectBeingModified, struct FPropertyChangedEvent& PropertyChangedEvent)
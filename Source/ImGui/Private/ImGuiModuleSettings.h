@@ -226,6 +226,19 @@ protected:
 	UPROPERTY(EditAnywhere, config, Category = "DPI Scale", Meta = (ShowOnlyInnerProperties))
 	FImGuiDPIScaleInfo DPIScale;
 
+	// Target number of ImGui frames per second in every context. Zero (default) means that contexts are updated in
+	// every engine frame. Between updates widgets redraw the last frame and input is queued for the next update.
+	// Contexts switch to full rate while ImGui has an active item or wants to capture the mouse.
+	// This can be overridden with 'ImGui.UpdateRate' console variable.
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0))
+	float UpdateRate = 0.f;
+
+	// If enabled, ImGui contexts, font atlas and textures are not created until the first debug delegate is
+	// registered, input mode is enabled or the demo is shown. This saves startup time and memory in sessions that
+	// don't use ImGui, but it requires all ImGui calls to be made from within ImGui delegates.
+	UPROPERTY(EditAnywhere, config, Category = "Performance")
+	bool bLazyInitialization = false;
+
 	static UImGuiSettings* DefaultInstance;
 
 	friend class FImGuiModuleSettings;
@@ -277,6 +290,12 @@ public:
 	// Get the DPI Scale information.
 	const FImGuiDPIScaleInfo& GetDPIScaleInfo() const { return DPIScale; }
 
+	// Get the target number of ImGui frames per second or zero, if contexts should be updated in every frame.
+	float GetUpdateRate() const { return UpdateRate; }
+
+	// Whether creation of ImGui contexts should be delayed until ImGui is used.
+	bool UseLazyInitialization() const { return bLazyInitialization; }
+
 	// Delegate raised when ImGui Input Handle is changed.
 	FStringClassReferenceChangeDelegate OnImGuiInputHandlerClassChanged;
 
@@ -304,6 +323,8 @@ private:
 	void SetToggleInputKey(const FImGuiKeyInfo& KeyInfo);
 	void SetCanvasSizeInfo(const FImGuiCanvasSizeInfo& CanvasSizeInfo);
 	void SetDPIScaleInfo(const FImGuiDPIScaleInfo& ScaleInfo);
+	void SetUpdateRate(float Rate);
+	void SetLazyInitialization(bool bLazy);
 
 #if WITH_EDITOR
 	void OnPropertyChanged(class UObject* ObjectBeingModified, struct FPropertyChangedEvent& PropertyChangedEvent);
@@ -321,4 +342,6 @@ private:
 	bool bShareMouseInput = false;
 	bool bUseSoftwareCursor = false;
 	int32 InputProcessorPriority = 2;
+	float UpdateRate = 0.f;
+	bool bLazyInitialization = false;
 };
@@ -0,0 +1,224 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiVertexConversion.h"
+
+#include "ImGuiInteroperability.h"
+
+#include <Math/VectorRegister.h>
+
+#include <cstddef>
+
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+// Vectorized conversion loads position and UV of a vertex with a single 4-float load.
+static_assert(offsetof(ImDrawVert, uv) == offsetof(ImDrawVert, pos) + 2 * sizeof(float),
+	"ImDrawVert layout with UV directly following position is required by the vectorized vertex conversion.");
+
+namespace
+{
+#if ENGINE_COMPATIBILITY_LEGACY_VECTOR_REGISTER
+	using FVectorRegister = VectorRegister;
+#else
+	using FVectorRegister = VectorRegister4Float;
+#endif
+
+	// Affine transform reduced to single precision coefficients: P' = Origin + P.x * AxisX + P.y * AxisY.
+	struct FVertexTransform
+	{
+		explicit FVertexTransform(const FTransform2D& Transform)
+		{
+			const FVector2D Origin = Transform.TransformPoint(FVector2D{ 0.f, 0.f });
+			const FVector2D AxisX = Transform.TransformPoint(FVector2D{ 1.f, 0.f }) - Origin;
+			const FVector2D AxisY = Transform.TransformPoint(FVector2D{ 0.f, 1.f }) - Origin;
+
+			OriginX = Origin.X;
+			OriginY = Origin.Y;
+			AxisXX = AxisX.X;
+			AxisXY = AxisX.Y;
+			AxisYX = AxisY.X;
+			AxisYY = AxisY.Y;
+		}
+
+		float OriginX, OriginY;
+		float AxisXX, AxisXY;
+		float AxisYX, AxisYY;
+	};
+
+	using ETransformType = ImGuiVertexConversion::ETransformType;
+
+	template<ETransformType TransformType>
+	FORCEINLINE void ConvertVertex(const FVertexTransform& Transform, const ImDrawVert& ImGuiVertex, FSlateVertex& SlateVertex)
+	{
+		// Final UV is calculated in shader as XY * ZW, so we need set all components.
+		SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
+		SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
+		SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
+
+		if (TransformType == ETransformType::Identity)
+		{
+			SlateVertex.Position.X = ImGuiVertex.pos.x;
+			SlateVertex.Position.Y = ImGuiVertex.pos.y;
+		}
+		else if (TransformType == ETransformType::Translation)
+		{
+			SlateVertex.Position.X = Transform.OriginX + ImGuiVertex.pos.x;
+			SlateVertex.Position.Y = Transform.OriginY + ImGuiVertex.pos.y;
+		}
+		else if (TransformType == ETransformType::UniformScale)
+		{
+			SlateVertex.Position.X = Transform.OriginX + ImGuiVertex.pos.x * Transform.AxisXX;
+			SlateVertex.Position.Y = Transform.OriginY + ImGuiVertex.pos.y * Transform.AxisXX;
+		}
+		else
+		{
+			SlateVertex.Position.X = Transform.OriginX + ImGuiVertex.pos.x * Transform.AxisXX + ImGuiVertex.pos.y * Transform.AxisYX;
+			SlateVertex.Position.Y = Transform.OriginY + ImGuiVertex.pos.x * Transform.AxisXY + ImGuiVertex.pos.y * Transform.AxisYY;
+		}
+
+		SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
+	}
+
+	template<ETransformType TransformType>
+	void ConvertVectorizedImpl(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FVertexTransform& VertexTransform)
+	{
+		// Positions are transformed in pairs, with the first vertex in lanes XY and the second one in lanes ZW.
+		const FVectorRegister Origin = MakeVectorRegister(VertexTransform.OriginX, VertexTransform.OriginY, VertexTransform.OriginX, VertexTransform.OriginY);
+		const FVectorRegister AxisX = MakeVectorRegister(VertexTransform.AxisXX, VertexTransform.AxisXY, VertexTransform.AxisXX, VertexTransform.AxisXY);
+		const FVectorRegister AxisY = MakeVectorRegister(VertexTransform.AxisYX, VertexTransform.AxisYY, VertexTransform.AxisYX, VertexTransform.AxisYY);
+		const FVectorRegister Scale = MakeVectorRegister(VertexTransform.AxisXX, VertexTransform.AxisXX, VertexTransform.AxisXX, VertexTransform.AxisXX);
+		const FVectorRegister One = MakeVectorRegister(1.f, 1.f, 1.f, 1.f);
+
+		// Transform positions of two vertices: (x0, y0, x1, y1).
+		auto TransformPositions = [&](const FVectorRegister& VertexA, const FVectorRegister& VertexB) -> FVectorRegister
+		{
+			if (TransformType == ETransformType::Identity)
+			{
+				return VectorShuffle(VertexA, VertexB, 0, 1, 0, 1);
+			}
+			else if (TransformType == ETransformType::Translation)
+			{
+				return VectorAdd(VectorShuffle(VertexA, VertexB, 0, 1, 0, 1), Origin);
+			}
+			else if (TransformType == ETransformType::UniformScale)
+			{
+				return VectorMultiplyAdd(VectorShuffle(VertexA, VertexB, 0, 1, 0, 1), Scale, Origin);
+			}
+			else
+			{
+				// Origin + (x0, x0, x1, x1) * AxisX + (y0, y0, y1, y1) * AxisY.
+				return VectorMultiplyAdd(VectorShuffle(VertexA, VertexB, 1, 1, 1, 1), AxisY,
+					VectorMultiplyAdd(VectorShuffle(VertexA, VertexB, 0, 0, 0, 0), AxisX, Origin));
+			}
+		};
+
+		alignas(16) float Positions[8];
+
+		int32 Idx = 0;
+		for (; Idx + 4 <= Num; Idx += 4)
+		{
+			const ImDrawVert* RESTRICT ImGuiVertices = Src + Idx;
+			FSlateVertex* RESTRICT SlateVertices = Dst + Idx;
+
+			// Load position and UV of each vertex: (pos.x, pos.y, uv.x, uv.y).
+			const FVectorRegister Vertex0 = VectorLoad(&ImGuiVertices[0].pos.x);
+			const FVectorRegister Vertex1 = VectorLoad(&ImGuiVertices[1].pos.x);
+			const FVectorRegister Vertex2 = VectorLoad(&ImGuiVertices[2].pos.x);
+			const FVectorRegister Vertex3 = VectorLoad(&ImGuiVertices[3].pos.x);
+
+			VectorStoreAligned(TransformPositions(Vertex0, Vertex1), Positions);
+			VectorStoreAligned(TransformPositions(Vertex2, Vertex3), Positions + 4);
+
+			// Final UV is calculated in shader as XY * ZW, so we need set all components: (uv.x, uv.y, 1, 1).
+			VectorStore(VectorShuffle(Vertex0, One, 2, 3, 0, 1), SlateVertices[0].TexCoords);
+			VectorStore(VectorShuffle(Vertex1, One, 2, 3, 0, 1), SlateVertices[1].TexCoords);
+			VectorStore(VectorShuffle(Vertex2, One, 2, 3, 0, 1), SlateVertices[2].TexCoords);
+			VectorStore(VectorShuffle(Vertex3, One, 2, 3, 0, 1), SlateVertices[3].TexCoords);
+
+			for (int32 Lane = 0; Lane < 4; Lane++)
+			{
+				SlateVertices[Lane].Position.X = Positions[Lane * 2];
+				SlateVertices[Lane].Position.Y = Positions[Lane * 2 + 1];
+				SlateVertices[Lane].Color = ImGuiInterops::UnpackImU32Color(ImGuiVertices[Lane].col);
+			}
+		}
+
+		// Convert remaining vertices.
+		for (; Idx < Num; Idx++)
+		{
+			ConvertVertex<TransformType>(VertexTransform, Src[Idx], Dst[Idx]);
+		}
+	}
+}
+
+namespace ImGuiVertexConversion
+{
+	ETransformType GetTransformType(const FTransform2D& Transform)
+	{
+		// Classify transform in the same precision as it is applied.
+		const FVertexTransform VertexTransform{ Transform };
+
+		if (VertexTransform.AxisXY != 0.f || VertexTransform.AxisYX != 0.f || VertexTransform.AxisXX != VertexTransform.AxisYY)
+		{
+			return ETransformType::General;
+		}
+
+		if (VertexTransform.AxisXX != 1.f)
+		{
+			return ETransformType::UniformScale;
+		}
+
+		return (VertexTransform.OriginX != 0.f || VertexTransform.OriginY != 0.f) ? ETransformType::Translation : ETransformType::Identity;
+	}
+
+	void ConvertScalar(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform)
+	{
+		for (int32 Idx = 0; Idx < Num; Idx++)
+		{
+			const ImDrawVert& ImGuiVertex = Src[Idx];
+			FSlateVertex& SlateVertex = Dst[Idx];
+
+			// Final UV is calculated in shader as XY * ZW, so we need set all components.
+			SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
+			SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
+			SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
+
+#if ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
+			SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+#else
+			SlateVertex.Position = (FVector2f)Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+#endif // ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
+
+			// Unpack ImU32 color.
+			SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
+		}
+	}
+
+	void ConvertVectorized(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform)
+	{
+		ConvertVectorized(Src, Dst, Num, Transform, GetTransformType(Transform));
+	}
+
+	void ConvertVectorized(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform, ETransformType TransformType)
+	{
+		const FVertexTransform VertexTransform{ Transform };
+
+		switch (TransformType)
+		{
+		case ETransformType::Identity:
+			ConvertVectorizedImpl<ETransformType::Identity>(Src, Dst, Num, VertexTransform);
+			break;
+		case ETransformType::Translation:
+			ConvertVectorizedImpl<ETransformType::Translation>(Src, Dst, Num, VertexTransform);
+			break;
+		case ETransformType::UniformScale:
+			ConvertVectorizedImpl<ETransformType::UniformScale>(Src, Dst, Num, VertexTransform);
+			break;
+		default:
+			ConvertVectorizedImpl<ETransformType::General>(Src, Dst, Num, VertexTransform);
+			break;
+		}
+	}
+}
+
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
@@ -0,0 +1,70 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "VersionCompatibility.h"
+
+#include <Rendering/RenderingCommon.h>
+
+#include <imgui.h>
+
+
+// Kernels converting ImGui vertices to Slate vertices. They are used by FImGuiDrawList but are also exposed, so they can
+// be benchmarked against each other.
+namespace ImGuiVertexConversion
+{
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Whether the default conversion uses vector intrinsics on this platform (SSE or NEON).
+	constexpr bool IsVectorized()
+	{
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Classes of transforms with specialized conversions. Each class is a special case of all classes that follow it.
+	enum class ETransformType : uint8
+	{
+		Identity,
+		Translation,
+		UniformScale,
+		General
+	};
+
+	// Get the most specialized class of the transform.
+	ETransformType GetTransformType(const FTransform2D& Transform);
+
+	// Reference conversion, which transforms every vertex separately using the full transform. It is used as a fallback
+	// on platforms without vector intrinsics.
+	// @param Src - Source ImGui vertices
+	// @param Dst - Destination Slate vertices (needs to have space for at least Num vertices)
+	// @param Num - Number of vertices to convert
+	// @param Transform - Transform to apply to all vertices
+	void ConvertScalar(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform);
+
+	// Vectorized conversion, which processes 4 vertices per iteration with transform reduced to single precision.
+	// It uses a specialization selected by GetTransformType. See ConvertScalar for parameters.
+	void ConvertVectorized(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform);
+
+	// Vectorized conversion using explicitly selected specialization. Transform must belong to the selected class
+	// (General can be used with any transform). See ConvertScalar for other parameters.
+	// @param TransformType - Class of the transform
+	void ConvertVectorized(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform, ETransformType TransformType);
+
+	// Convert vertices using the best conversion available on this platform.
+	// See ConvertScalar for parameters.
+	FORCEINLINE void Convert(const ImDrawVert* Src, FSlateVertex* Dst, int32 Num, const FTransform2D& Transform)
+	{
+		if (IsVectorized())
+		{
+			ConvertVectorized(Src, Dst, Num, Transform);
+		}
+		else
+		{
+			ConvertScalar(Src, Dst, Num, Transform);
+		}
+	}
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+}
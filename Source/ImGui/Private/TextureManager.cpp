@@ -42,6 +42,37 @@ TextureIndex FTextureManager::CreateTextureResources(const FName& Name, UTexture
 	return AddTextureEntry(Name, Texture, false);
 }
 
+bool FTextureManager::IsAlphaTexture(TextureIndex Index) const
+{
+	const UTexture2D* Texture = Cast<UTexture2D>(GetTextureObject(Index));
+	return Texture && Texture->GetPixelFormat() == PF_G8;
+}
+
+void FTextureManager::UpdateTextureRegion(TextureIndex Index, const FIntRect& Region, uint32 SrcBpp, const uint8* SrcData, uint32 SrcPitch)
+{
+	UTexture2D* Texture = Cast<UTexture2D>(GetTextureObject(Index));
+	if (!Texture || !SrcData || Region.Area() <= 0)
+	{
+		return;
+	}
+
+	// Update is executed on the render thread, so we pass a copy of the region, which is released after the upload.
+	const uint32 RegionPitch = Region.Width() * SrcBpp;
+	uint8* RegionData = new uint8[RegionPitch * Region.Height()];
+	for (int32 Row = 0; Row < Region.Height(); Row++)
+	{
+		FMemory::Memcpy(RegionData + Row * RegionPitch, SrcData + (Region.Min.Y + Row) * SrcPitch + Region.Min.X * SrcBpp, RegionPitch);
+	}
+
+	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(Region.Min.X, Region.Min.Y, 0, 0, Region.Width(), Region.Height());
+	Texture->UpdateTextureRegions(0, 1, TextureRegion, RegionPitch, SrcBpp, RegionData,
+		[](uint8* Data, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] Data;
+			delete Regions;
+		});
+}
+
 void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 {
 	checkf(IsInRange(Index), TEXT("Invalid texture index %d. Texture resources array has %d entries total."), Index, TextureResources.Num());
@@ -51,8 +82,12 @@ void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 
 TextureIndex FTextureManager::CreateTextureInternal(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup)
 {
-	// Create a texture.
-	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height);
+	// Create a texture. Single-channel data contain linear coverage, so they shouldn't be treated as sRGB.
+	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, SrcBpp == 1 ? PF_G8 : PF_B8G8R8A8);
+	if (SrcBpp == 1)
+	{
+		Texture->SRGB = false;
+	}
 
 	// Create a new resource for that texture.
 	Texture->UpdateResource();
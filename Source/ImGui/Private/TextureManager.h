@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <Math/IntRect.h>
 #include <Styling/SlateBrush.h>
 #include <Textures/SlateShaderResource.h>
 #include <UObject/WeakObjectPtr.h>
@@ -76,12 +77,28 @@ public:
 	// @param Name - The texture name
 	// @param Width - The texture width
 	// @param Height - The texture height
-	// @param SrcBpp - The size in bytes of one pixel
+	// @param SrcBpp - The size in bytes of one pixel: 4 for BGRA data or 1 for single-channel data like ImGui Alpha8
+	// font atlas (see IsAlphaTexture)
 	// @param SrcData - The source data
 	// @param SrcDataCleanup - Optional function called to release source data after texture is created (only needed, if data need to be released)
 	// @returns The index of a texture that was created
 	TextureIndex CreateTexture(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup = [](uint8*) {});
 
+	// Update a part of an existing texture, without recreating it. Source data are copied, so they can be modified
+	// after this call returns.
+	// @param Index - Index of a texture created with CreateTexture
+	// @param Region - The region to update
+	// @param SrcBpp - The size in bytes of one pixel, which must match the texture format
+	// @param SrcData - The source data of the whole texture
+	// @param SrcPitch - The size in bytes of one row of the source data
+	void UpdateTextureRegion(TextureIndex Index, const FIntRect& Region, uint32 SrcBpp, const uint8* SrcData, uint32 SrcPitch);
+
+	// Check whether texture at given index is a single-channel texture. Such textures store alpha in the red channel,
+	// so they need to be rendered with ImGui shaders, which treat them as white color with that alpha.
+	// @param Index - Index of a texture
+	// @returns True, if texture at given index is valid and has a single channel
+	bool IsAlphaTexture(TextureIndex Index) const;
+
 	// Create a plain texture.
 	// @param Name - The texture name
 	// @param Width - The texture width
@@ -0,0 +1,159 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "Utilities/WorldContextIndex.h"
+
+#include <Containers/Array.h>
+#include <Misc/Optional.h>
+
+
+// Dense storage for data associated with ImGui contexts.
+
+namespace Utilities
+{
+	// Handle to an element in TContextSlotArray. It stays valid for as long as the element is not removed, even if
+	// another element is later added under the same context index.
+	struct FContextSlotHandle
+	{
+		int32 Slot = INDEX_NONE;
+		uint32 Serial = 0;
+
+		bool IsValid() const { return Slot != INDEX_NONE; }
+
+		friend bool operator==(const FContextSlotHandle& Lhs, const FContextSlotHandle& Rhs)
+		{
+			return Lhs.Slot == Rhs.Slot && Lhs.Serial == Rhs.Serial;
+		}
+
+		friend bool operator!=(const FContextSlotHandle& Lhs, const FContextSlotHandle& Rhs)
+		{
+			return !(Lhs == Rhs);
+		}
+	};
+
+	// Array of elements addressed by context index. Context indices are small and dense (invalid, standalone, editor
+	// and PIE instances), so they map directly to slots, which allows lookups without hashing.
+	template<typename T>
+	class TContextSlotArray
+	{
+	public:
+
+		// Get element for context index or null, if there is no such element.
+		FORCEINLINE T* Find(int32 ContextIndex)
+		{
+			const int32 Slot = ToSlot(ContextIndex);
+			return Slots.IsValidIndex(Slot) && Slots[Slot].Value.IsSet() ? &Slots[Slot].Value.GetValue() : nullptr;
+		}
+
+		FORCEINLINE const T* Find(int32 ContextIndex) const
+		{
+			return const_cast<TContextSlotArray*>(this)->Find(ContextIndex);
+		}
+
+		// Get element for handle or null, if element pointed by that handle was removed.
+		FORCEINLINE T* Find(const FContextSlotHandle& Handle)
+		{
+			return Slots.IsValidIndex(Handle.Slot) && Slots[Handle.Slot].Serial == Handle.Serial && Slots[Handle.Slot].Value.IsSet()
+				? &Slots[Handle.Slot].Value.GetValue() : nullptr;
+		}
+
+		FORCEINLINE const T* Find(const FContextSlotHandle& Handle) const
+		{
+			return const_cast<TContextSlotArray*>(this)->Find(Handle);
+		}
+
+		// Get a handle to element for context index or invalid handle, if there is no such element.
+		FContextSlotHandle GetHandle(int32 ContextIndex) const
+		{
+			const int32 Slot = ToSlot(ContextIndex);
+			return Slots.IsValidIndex(Slot) && Slots[Slot].Value.IsSet() ? FContextSlotHandle{ Slot, Slots[Slot].Serial } : FContextSlotHandle{};
+		}
+
+		// Check whether there is an element for context index.
+		bool Contains(int32 ContextIndex) const { return Find(ContextIndex) != nullptr; }
+
+		// Get element for context index, adding a default one if needed.
+		T& FindOrAdd(int32 ContextIndex)
+		{
+			T* Value = Find(ContextIndex);
+			return Value ? *Value : Emplace(ContextIndex);
+		}
+
+		// Construct a new element for context index, replacing the existing one. Like with other engine containers,
+		// adding elements can invalidate references to the other elements.
+		template<typename... ArgTypes>
+		T& Emplace(int32 ContextIndex, ArgTypes&&... Args)
+		{
+			const int32 Slot = ToSlot(ContextIndex);
+			checkf(Slot >= 0, TEXT("Context index %d is out of range."), ContextIndex);
+
+			if (Slot >= Slots.Num())
+			{
+				Slots.SetNum(Slot + 1);
+			}
+
+			FSlot& Entry = Slots[Slot];
+			Entry.Value.Emplace(Forward<ArgTypes>(Args)...);
+			Entry.Serial = ++LastSerial;
+			return Entry.Value.GetValue();
+		}
+
+		// Remove element for context index.
+		void Remove(int32 ContextIndex)
+		{
+			const int32 Slot = ToSlot(ContextIndex);
+			if (Slots.IsValidIndex(Slot))
+			{
+				Slots[Slot].Value.Reset();
+			}
+		}
+
+		// Remove all elements.
+		void Reset()
+		{
+			Slots.Reset();
+		}
+
+		// Call functor for every element in order of context indices.
+		// @param Functor - Functor with signature void(int32 ContextIndex, T& Value)
+		template<typename FunctorType>
+		void ForEach(FunctorType&& Functor)
+		{
+			for (int32 Slot = 0; Slot < Slots.Num(); Slot++)
+			{
+				if (Slots[Slot].Value.IsSet())
+				{
+					Functor(ToContextIndex(Slot), Slots[Slot].Value.GetValue());
+				}
+			}
+		}
+
+		template<typename FunctorType>
+		void ForEach(FunctorType&& Functor) const
+		{
+			for (int32 Slot = 0; Slot < Slots.Num(); Slot++)
+			{
+				if (Slots[Slot].Value.IsSet())
+				{
+					Functor(ToContextIndex(Slot), Slots[Slot].Value.GetValue());
+				}
+			}
+		}
+
+	private:
+
+		struct FSlot
+		{
+			TOptional<T> Value;
+			uint32 Serial = 0;
+		};
+
+		// Slots start from invalid context index, which is the lowest one and can still be used as a key.
+		static FORCEINLINE int32 ToSlot(int32 ContextIndex) { return ContextIndex - INVALID_CONTEXT_INDEX; }
+		static FORCEINLINE int32 ToContextIndex(int32 Slot) { return Slot + INVALID_CONTEXT_INDEX; }
+
+		TArray<FSlot> Slots;
+		uint32 LastSerial = 0;
+	};
+}
@@ -36,5 +36,14 @@
 
 #define ENGINE_COMPATIBILITY_LEGACY_VECTOR2F            BELOW_ENGINE_VERSION(5, 0)
 
+// Starting from version 5.0, VectorRegister is a double-precision register and single-precision math requires
+// VectorRegister4Float.
+#define ENGINE_COMPATIBILITY_LEGACY_VECTOR_REGISTER     BELOW_ENGINE_VERSION(5, 0)
+
 // Starting from version 5.4, bAllowShrinking is deprecated in favour of EAllowShrinking enum.
 #define ENGINE_COMPATIBILITY_LEGACY_CONTAINER_SHRINKING	BELOW_ENGINE_VERSION(5, 4)
+
+// Custom draw element depends on ICustomSlateElement::DrawRenderThread(FRHICommandListImmediate&, const void*) receiving
+// a pointer to FTextureRHIRef as the render target. This is only verified with version 5.3, so in other versions ImGui
+// output is always rendered by Slate.
+#define ENGINE_COMPATIBILITY_WITH_CUSTOM_DRAW_ELEMENT	(FROM_ENGINE_VERSION(5, 3) && BELOW_ENGINE_VERSION(5, 4))
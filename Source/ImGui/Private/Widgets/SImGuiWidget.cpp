@@ -3,8 +3,10 @@
 #include "SImGuiWidget.h"
 #include "SImGuiCanvasControl.h"
 
+#include "ImGuiContextAllocator.h"
 #include "ImGuiContextManager.h"
 #include "ImGuiContextProxy.h"
+#include "ImGuiDrawElement.h"
 #include "ImGuiInputHandler.h"
 #include "ImGuiInputHandlerFactory.h"
 #include "ImGuiInteroperability.h"
@@ -45,6 +47,21 @@ DEFINE_LOG_CATEGORY_STATIC(LogImGuiWidget, Warning, All);
 
 #endif // IMGUI_WIDGET_DEBUG
 
+#if IMGUI_WITH_DRAW_ELEMENT
+namespace CVars
+{
+	TAutoConsoleVariable<int> CustomDrawElement(TEXT("ImGui.CustomDrawElement"), 0,
+		TEXT("Render ImGui output with a custom Slate element, which uses ImGui vertex format and shaders, instead of\n")
+		TEXT("converting it to Slate vertices. Only available in UE 5.3, which has a verified custom Slate element interface.\n")
+		TEXT("Only this path applies the ImGui-to-screen transform in the shader. Slate custom vertices have no render\n")
+		TEXT("transform, so when disabled, the transform is baked into converted vertices and panning or zooming the canvas\n")
+		TEXT("converts them again.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+}
+#endif // IMGUI_WITH_DRAW_ELEMENT
+
 #if IMGUI_WIDGET_DEBUG
 namespace CVars
 {
@@ -94,7 +111,7 @@ void SImGuiWidget::Construct(const FArguments& InArgs)
 	ModuleManager->OnPostImGuiUpdate().AddRaw(this, &SImGuiWidget::OnPostImGuiUpdate);
 
 	// Register debug delegate.
-	auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+	auto* ContextProxy = GetContextProxy();
 	checkf(ContextProxy, TEXT("Missing context during widget construction: ContextIndex = %d"), ContextIndex);
 #if IMGUI_WIDGET_DEBUG
 	ContextProxy->OnDraw().AddRaw(this, &SImGuiWidget::OnDebugDraw);
@@ -135,7 +152,7 @@ SImGuiWidget::~SImGuiWidget()
 	ReleaseInputHandler();
 
 	// Remove binding between this widget and its context proxy.
-	if (auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex))
+	if (auto* ContextProxy = GetContextProxy())
 	{
 #if IMGUI_WIDGET_DEBUG
 		ContextProxy->OnDraw().RemoveAll(this);
@@ -154,6 +171,18 @@ void SImGuiWidget::Tick(const FGeometry& AllottedGeometry, const double InCurren
 	UpdateTransparentMouseInput(AllottedGeometry);
 	HandleWindowFocusLost();
 	UpdateCanvasSize();
+
+#if IMGUI_WIDGET_DEBUG
+	// Debug windows are not drawn by delegates, so they need to wake up the context, if it is hibernating.
+	if (CVars::DebugWidget.GetValueOnGameThread() > 0 || CVars::DebugInput.GetValueOnGameThread() > 0)
+	{
+		FImGuiContextProxy* ContextProxy = GetContextProxy();
+		if (ContextProxy && ContextProxy->IsHibernating())
+		{
+			ContextProxy->RequestRedraw();
+		}
+	}
+#endif // IMGUI_WIDGET_DEBUG
 }
 
 FReply SImGuiWidget::OnKeyChar(const FGeometry& MyGeometry, const FCharacterEvent& CharacterEvent)
@@ -338,6 +367,21 @@ void SImGuiWidget::UnregisterImGuiSettingsDelegates()
 	Settings.OnCanvasSizeChangedDelegate.RemoveAll(this);
 }
 
+FImGuiContextProxy* SImGuiWidget::GetContextProxy() const
+{
+	FImGuiContextManager& ContextManager = ModuleManager->GetContextManager();
+
+	// Handle is refreshed only when context is (re)created, otherwise lookup is just a slot check.
+	FImGuiContextProxy* ContextProxy = ContextManager.GetContextProxy(ContextHandle);
+	if (UNLIKELY(!ContextProxy))
+	{
+		ContextHandle = ContextManager.GetContextHandle(ContextIndex);
+		ContextProxy = ContextManager.GetContextProxy(ContextHandle);
+	}
+
+	return ContextProxy;
+}
+
 void SImGuiWidget::SetHideMouseCursor(bool bHide)
 {
 	if (bHideMouseCursor != bHide)
@@ -366,7 +410,7 @@ void SImGuiWidget::UpdateMouseCursor()
 {
 	if (!bHideMouseCursor)
 	{
-		const FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+		const FImGuiContextProxy* ContextProxy = GetContextProxy();
 		SetCursor(ContextProxy ? ContextProxy->GetMouseCursor() : EMouseCursor::Default);
 	}
 	else
@@ -437,7 +481,7 @@ void SImGuiWidget::ReturnFocus()
 void SImGuiWidget::UpdateInputState()
 {
 	auto& Properties = ModuleManager->GetProperties();
-	auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+	auto* ContextProxy = GetContextProxy();
 
 	const bool bEnableTransparentMouseInput = Properties.IsMouseInputShared()
 #if PLATFORM_ANDROID || PLATFORM_IOS
@@ -592,7 +636,7 @@ void SImGuiWidget::UpdateCanvasSize()
 {
 	if (bUpdateCanvasSize)
 	{
-		if (auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex))
+		if (auto* ContextProxy = GetContextProxy())
 		{
 			CanvasSize = MinCanvasSize;
 			if (bAdaptiveCanvasSize && GameViewport.IsValid())
@@ -639,7 +683,7 @@ FVector2D SImGuiWidget::TransformScreenPointToImGui(const FGeometry& MyGeometry,
 int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect,
 	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& WidgetStyle, bool bParentEnabled) const
 {
-	if (FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex))
+	if (FImGuiContextProxy* ContextProxy = GetContextProxy())
 	{
 		// Manually update ImGui context to minimise lag between creating and rendering ImGui output. This will also
 		// keep frame tearing at minimum because it is executed at the very end of the frame.
@@ -650,30 +694,41 @@ int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 		const FSlateRenderTransform& WidgetToScreen = AllottedGeometry.GetAccumulatedRenderTransform();
 		const FSlateRenderTransform ImGuiToScreen = RoundTranslation(ImGuiRenderTransform.Concatenate(WidgetToScreen));
 
+#if IMGUI_WITH_DRAW_ELEMENT
+		// Single-channel font atlas can only be rendered with ImGui shaders.
+		if (CVars::CustomDrawElement.GetValueOnGameThread() > 0 || ModuleManager->IsFontAtlasTextureAlpha())
+		{
+			if (!DrawElement.IsValid())
+			{
+				DrawElement = MakeShared<FImGuiDrawElement, ESPMode::ThreadSafe>();
+			}
+
+			// Pass raw draw data to the custom element, which handles clipping on its own.
+			DrawElement->Update(ContextProxy->GetDrawData(), ImGuiToScreen, MyClippingRect, ModuleManager->GetTextureManager());
+			FSlateDrawElement::MakeCustom(OutDrawElements, LayerId, DrawElement);
+
+			return Super::OnPaint(Args, AllottedGeometry, MyClippingRect, OutDrawElements, LayerId, WidgetStyle, bParentEnabled);
+		}
+#endif // IMGUI_WITH_DRAW_ELEMENT
+
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 		// Convert clipping rectangle to format required by Slate vertex.
 		const FSlateRotatedRect VertexClippingRect{ MyClippingRect };
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-
-		for (const auto& DrawList : ContextProxy->GetDrawData())
-		{
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-			DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, VertexClippingRect);
+		const TArray<FImGuiSlateDrawList>& SlateDrawLists = ContextProxy->GetSlateDrawData(ImGuiToScreen, VertexClippingRect);
 #else
-			DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen);
+		// Get draw data converted to Slate format (cached by context, so it is only converted once per frame).
+		const TArray<FImGuiSlateDrawList>& SlateDrawLists = ContextProxy->GetSlateDrawData(ImGuiToScreen, MyClippingRect);
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-			for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+		for (const FImGuiSlateDrawList& DrawList : SlateDrawLists)
+		{
+			for (const FImGuiSlateDrawBatch& DrawBatch : DrawList.Batches)
 			{
-				const auto& DrawCommand = DrawList.GetCommand(CommandNb, ImGuiToScreen);
+				// Get texture resource handle for this batch (null index will be also mapped to a valid texture).
+				const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(DrawBatch.TextureId);
 
-				DrawList.CopyIndexData(IndexBuffer, DrawCommand.IndexOffset, DrawCommand.NumElements);
-
-				// Get texture resource handle for this draw command (null index will be also mapped to a valid texture).
-				const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(DrawCommand.TextureId);
-
-				// Transform clipping rectangle to screen space and apply to elements that we draw.
-				const FSlateRect ClippingRect = DrawCommand.ClippingRect.IntersectionWith(MyClippingRect);
+				// Apply clipping rectangle, which is already transformed to screen space, to elements that we draw.
+				const FSlateRect ClippingRect = DrawBatch.ClippingRect.IntersectionWith(MyClippingRect);
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 				// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
@@ -683,8 +738,8 @@ int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 				OutDrawElements.PushClip(FSlateClippingZone{ ClippingRect });
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-				// Add elements to the list.
-				FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, VertexBuffer, IndexBuffer, nullptr, 0, 0);
+				// Add elements to the list. Every batch brings its own slice of vertices.
+				FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, DrawBatch.VertexBuffer, DrawBatch.IndexBuffer, nullptr, 0, 0);
 
 #if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 				OutDrawElements.PopClip();
@@ -848,7 +903,7 @@ namespace Styles
 
 void SImGuiWidget::OnDebugDraw()
 {
-	FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+	FImGuiContextProxy* ContextProxy = GetContextProxy();
 
 	if (CVars::DebugWidget.GetValueOnGameThread() > 0)
 	{
@@ -879,6 +934,41 @@ void SImGuiWidget::OnDebugDraw()
 				TwoColumns::Value("ImGui Scale", ContextProxy ? ContextProxy->GetDPIScale() : 1.f);
 			});
 
+			TwoColumns::CollapsingGroup("Draw Data", [&]()
+			{
+				TwoColumns::Value("Draw List Cache Hits", ContextProxy ? ContextProxy->GetDrawListCacheHits() : 0u);
+				TwoColumns::Value("Draw List Cache Misses", ContextProxy ? ContextProxy->GetDrawListCacheMisses() : 0u);
+				TwoColumns::Value("Update Rate", ContextProxy ? ContextProxy->GetUpdateRate() : 0.f);
+				TwoColumns::Value("Skipped Updates", ContextProxy ? ContextProxy->GetSkippedUpdates() : 0u);
+				TwoColumns::Value("Is Idle", ContextProxy ? ContextProxy->IsIdle() : false);
+				TwoColumns::Value("Idle Updates", ContextProxy ? ContextProxy->GetIdleUpdates() : 0u);
+				TwoColumns::Value("Hibernating Contexts", ModuleManager->GetContextManager().GetNumHibernatingContexts());
+			});
+
+			TwoColumns::CollapsingGroup("Memory", [&]()
+			{
+				if (ContextProxy)
+				{
+					const FImGuiContextAllocator& Allocator = ContextProxy->GetAllocator();
+					TwoColumns::Value("Live KB", static_cast<uint32>(Allocator.GetLiveBytes() / 1024));
+					TwoColumns::Value("Peak KB", static_cast<uint32>(Allocator.GetPeakBytes() / 1024));
+					TwoColumns::Value("Cached KB", static_cast<uint32>(Allocator.GetCachedBytes() / 1024));
+					TwoColumns::Value("Allocations Per Frame", Allocator.GetFrameAllocations());
+				}
+
+				// Font atlas is shared by all contexts.
+				const ImFontAtlas& FontAtlas = ModuleManager->GetContextManager().GetFontAtlas();
+				const bool bAlphaFontAtlas = ModuleManager->IsFontAtlasTextureAlpha();
+				const uint32 FontAtlasPixels = static_cast<uint32>(FontAtlas.TexWidth * FontAtlas.TexHeight);
+				TwoColumns::Value("Font Atlas Format", bAlphaFontAtlas ? TEXT("Alpha8") : TEXT("RGBA32"));
+				TwoColumns::Value("Font Atlas KB", FontAtlasPixels * (bAlphaFontAtlas ? 1 : 4) / 1024);
+				TwoColumns::Value("Font Atlas Saved KB", bAlphaFontAtlas ? FontAtlasPixels * 3 / 1024 : 0u);
+
+				const FImGuiDynamicGlyphs& DynamicGlyphs = ModuleManager->GetContextManager().GetDynamicGlyphs();
+				TwoColumns::Value("Dynamic Glyphs", DynamicGlyphs.GetNumGlyphs());
+				TwoColumns::Value("Evicted Glyph Pages", DynamicGlyphs.GetNumEvictedPages());
+			});
+
 			TwoColumns::CollapsingGroup("Input Mode", [&]()
 			{
 				TwoColumns::Value("Input Enabled", bInputEnabled);
@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include "ImGuiDrawElement.h"
 #include "ImGuiModuleDebug.h"
 #include "ImGuiModuleSettings.h"
+#include "Utilities/ContextSlotArray.h"
 
 #include <Rendering/RenderingCommon.h>
 #include <UObject/WeakObjectPtr.h>
@@ -14,6 +16,7 @@
 // Hide ImGui Widget debug in non-developer mode.
 #define IMGUI_WIDGET_DEBUG IMGUI_MODULE_DEVELOPER
 
+class FImGuiContextProxy;
 class FImGuiModuleManager;
 class SImGuiCanvasControl;
 class UImGuiInputHandler;
@@ -90,6 +93,9 @@ private:
 	void RegisterImGuiSettingsDelegates();
 	void UnregisterImGuiSettingsDelegates();
 
+	// Get context proxy using cached handle, or null if context doesn't exist.
+	FImGuiContextProxy* GetContextProxy() const;
+
 	void SetHideMouseCursor(bool bHide);
 
 	bool IsConsoleOpened() const;
@@ -137,10 +143,8 @@ private:
 	FSlateRenderTransform ImGuiTransform;
 	FSlateRenderTransform ImGuiRenderTransform;
 
-	mutable TArray<FSlateVertex> VertexBuffer;
-	mutable TArray<SlateIndex> IndexBuffer;
-
 	int32 ContextIndex = 0;
+	mutable Utilities::FContextSlotHandle ContextHandle;
 
 	FVector2D MinCanvasSize = FVector2D::ZeroVector;
 	FVector2D CanvasSize = FVector2D::ZeroVector;
@@ -157,4 +161,9 @@ private:
 
 	TSharedPtr<SImGuiCanvasControl> CanvasControlWidget;
 	TWeakPtr<SWidget> PreviousUserFocusedWidget;
+
+#if IMGUI_WITH_DRAW_ELEMENT
+	// Custom Slate element used when draw data are rendered with ImGui shaders (created on demand).
+	mutable TSharedPtr<FImGuiDrawElement, ESPMode::ThreadSafe> DrawElement;
+#endif // IMGUI_WITH_DRAW_ELEMENT
 };
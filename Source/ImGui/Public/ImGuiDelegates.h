@@ -57,6 +57,33 @@ public:
 	 * @returns Simple multicast delegate to debug events called once per frame for every world to debug
 	 */
 	static FSimpleMulticastDelegate& OnMultiContextDebug();
+
+	/**
+	 * Declare whether content drawn in ImGui context of current world (GWorld) is static. See SetStaticContent(UWorld*, bool).
+	 * @param bStatic - True, if content drawn in this context is static
+	 */
+	static void SetStaticContent(bool bStatic);
+
+	/**
+	 * Declare whether content drawn in ImGui context of given world is static, meaning that it changes only after ImGui
+	 * input or after explicit redraw request. Contexts with static content stop generating new frames while idle and
+	 * keep drawing the last frame, so debug delegates for that world are not called until context is woken up.
+	 * @param World - World which context should be affected
+	 * @param bStatic - True, if content drawn in this context is static
+	 */
+	static void SetStaticContent(UWorld* World, bool bStatic);
+
+	/**
+	 * Request a new frame in ImGui context of current world (GWorld). See RequestRedraw(UWorld*).
+	 */
+	static void RequestRedraw();
+
+	/**
+	 * Request a new frame in ImGui context of given world. Should be called when state shown by static content
+	 * changes, to wake up the idle context.
+	 * @param World - World which context should be updated
+	 */
+	static void RequestRedraw(UWorld* World);
 };
 
 
@@ -137,6 +137,23 @@ public:
 
 	virtual void RebuildFontAtlas();
 
+	/**
+	 * Request glyphs for characters in text, which are not in glyph ranges of the fonts. Missing glyphs are rasterized
+	 * and added to the font atlas before the next frame. This only works when dynamic glyphs are enabled with
+	 * 'ImGui.DynamicGlyphs' and text needs to be requested in every frame in which it is displayed, otherwise its
+	 * glyphs can be evicted when atlas runs out of space. Can be called from any thread.
+	 *
+	 * @param Text - Text that will be displayed
+	 */
+	virtual void RequestGlyphs(const FString& Text);
+
+	/**
+	 * Request glyphs for characters in UTF-8 text (see RequestGlyphs above).
+	 *
+	 * @param Text - Null-terminated UTF-8 text that will be displayed
+	 */
+	virtual void RequestGlyphs(const char* Text);
+
 	/**
 	 * Get ImGui module properties.
 	 *
@@ -0,0 +1,40 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+using UnrealBuildTool;
+
+// Global shaders used to render ImGui draw data. They are kept in a separate module, because global shaders need to be
+// registered during PostConfigInit loading phase, which is too early for the main ImGui module.
+public class ImGuiShaders : ModuleRules
+{
+#if WITH_FORWARDED_MODULE_RULES_CTOR
+	public ImGuiShaders(ReadOnlyTargetRules Target) : base(Target)
+#else
+	public ImGuiShaders(TargetInfo Target)
+#endif
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+#if UE_4_24_OR_LATER
+		bLegacyPublicIncludePaths = false;
+		ShadowVariableWarningLevel = WarningLevel.Error;
+		bTreatAsEngineModule = true;
+#endif
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"RenderCore",
+				"RHI"
+			}
+			);
+
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Projects"
+			}
+			);
+	}
+}
@@ -0,0 +1,32 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiShaders.h"
+
+#include <Interfaces/IPluginManager.h>
+#include <Misc/Paths.h>
+#include <Modules/ModuleManager.h>
+
+#if IMGUI_WITH_SHADERS
+#include <ShaderCore.h>
+#endif
+
+
+#if IMGUI_WITH_SHADERS
+IMPLEMENT_GLOBAL_SHADER(FImGuiVS, "/Plugin/ImGui/Private/ImGui.usf", "MainVS", SF_Vertex);
+IMPLEMENT_GLOBAL_SHADER(FImGuiPS, "/Plugin/ImGui/Private/ImGui.usf", "MainPS", SF_Pixel);
+#endif // IMGUI_WITH_SHADERS
+
+class FImGuiShadersModule : public IModuleInterface
+{
+public:
+
+	virtual void StartupModule() override
+	{
+#if IMGUI_WITH_SHADERS
+		const FString ShadersDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("ImGui"))->GetBaseDir(), TEXT("Shaders"));
+		AddShaderSourceDirectoryMapping(TEXT("/Plugin/ImGui"), ShadersDir);
+#endif // IMGUI_WITH_SHADERS
+	}
+};
+
+IMPLEMENT_MODULE(FImGuiShadersModule, ImGuiShaders)
@@ -0,0 +1,45 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Misc/EngineVersionComparison.h>
+
+// Shaders are only implemented for engine versions with the current RHI command list API.
+#define IMGUI_WITH_SHADERS !UE_VERSION_OLDER_THAN(5, 3, 0)
+
+#if IMGUI_WITH_SHADERS
+
+#include <GlobalShader.h>
+#include <ShaderParameterStruct.h>
+
+
+// Vertex shader transforming ImGui vertices (see ImDrawVert) from ImGui space to clip space.
+class IMGUISHADERS_API FImGuiVS : public FGlobalShader
+{
+public:
+
+	DECLARE_GLOBAL_SHADER(FImGuiVS);
+	SHADER_USE_PARAMETER_STRUCT(FImGuiVS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FMatrix44f, ImGuiToClip)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+// Pixel shader modulating texture with vertex color, using the same gamma handling as Slate. Single-channel textures,
+// like the Alpha8 font atlas, are treated as white with alpha in the red channel.
+class IMGUISHADERS_API FImGuiPS : public FGlobalShader
+{
+public:
+
+	DECLARE_GLOBAL_SHADER(FImGuiPS);
+	SHADER_USE_PARAMETER_STRUCT(FImGuiPS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_TEXTURE(Texture2D, Texture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, TextureSampler)
+		SHADER_PARAMETER(uint32, TextureIsAlpha)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+#endif // IMGUI_WITH_SHADERS
@@ -116,7 +116,10 @@
 // Your renderer backend will need to support it (most example renderer backends support both 16/32-bit indices).
 // Another way to allow large meshes while keeping 16-bit indices is to handle ImDrawCmd::VtxOffset in your renderer.
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
+// UnrealImGui handles ImDrawCmd::VtxOffset, so 16-bit indices can be enabled in ImGui.Build.cs (IMGUI_USE_16BIT_INDICES).
+#if !defined(IMGUI_USE_16BIT_INDICES) || !IMGUI_USE_16BIT_INDICES
 #define ImDrawIdx unsigned int
+#endif
 
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;